@@ -1,8 +1,12 @@
 #include "benchmark/benchmark.h"
 
 #include "gl.h"
+#include "log.h"
 #include "map.h"
+#include "mockPlatform.h"
 
+#include "data/tileSource.h"
+#include "tile/tileTask.h"
 #include "util/builders.h"
 #include "glm/glm.hpp"
 #include <vector>
@@ -25,36 +29,138 @@ struct PosNormEnormColVertex {
     GLfloat layer;
 };
 
-static void BM_Tangram_BuildButtMiterLine(benchmark::State& state) {
+// Vertices emitted through the std::function of the builder context
+static void buildLineWithFunction(benchmark::State& state, CapTypes cap, JoinTypes join) {
     while(state.KeepRunning()) {
         std::vector<PosNormEnormColVertex> vertices;
         PolyLineBuilder builder {
             [&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
                 vertices.push_back({ coord, uv, normal, 0.5f, 0xffffff, 0.f });
             },
-            CapTypes::butt,
-            JoinTypes::miter
+            cap,
+            join
         };
 
         Builders::buildPolyLine(line, builder);
     }
 }
-BENCHMARK(BM_Tangram_BuildButtMiterLine);
 
-static void BM_Tangram_BuildRoundRoundLine(benchmark::State& state) {
+// Vertices emitted through a lambda passed to the templated builder
+static void buildLineWithSink(benchmark::State& state, CapTypes cap, JoinTypes join) {
     while(state.KeepRunning()) {
         std::vector<PosNormEnormColVertex> vertices;
-        PolyLineBuilder builder {
+        PolyLineBuilder builder { {}, cap, join };
+
+        Builders::buildPolyLine(line, builder,
             [&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
                 vertices.push_back({ coord, uv, normal, 0.5f, 0xffffff, 0.f });
-            },
-            CapTypes::round,
-            JoinTypes::round
-        };
-
-        Builders::buildPolyLine(line, builder);
+            });
     }
 }
+
+static void BM_Tangram_BuildButtMiterLine(benchmark::State& state) {
+    buildLineWithFunction(state, CapTypes::butt, JoinTypes::miter);
+}
+BENCHMARK(BM_Tangram_BuildButtMiterLine);
+
+static void BM_Tangram_BuildButtMiterLineSink(benchmark::State& state) {
+    buildLineWithSink(state, CapTypes::butt, JoinTypes::miter);
+}
+BENCHMARK(BM_Tangram_BuildButtMiterLineSink);
+
+static void BM_Tangram_BuildRoundRoundLine(benchmark::State& state) {
+    buildLineWithFunction(state, CapTypes::round, JoinTypes::round);
+}
 BENCHMARK(BM_Tangram_BuildRoundRoundLine);
 
+static void BM_Tangram_BuildRoundRoundLineSink(benchmark::State& state) {
+    buildLineWithSink(state, CapTypes::round, JoinTypes::round);
+}
+BENCHMARK(BM_Tangram_BuildRoundRoundLineSink);
+
+const char tile_file[] = "res/tile.mvt";
+
+// Polygons of all features in the benchmark tile
+static const std::vector<Polygon>& tilePolygons() {
+    static std::vector<Polygon> polygons;
+    if (!polygons.empty()) { return polygons; }
+
+    auto source = std::make_shared<TileSource>("bench", nullptr);
+    source->setFormat(TileSource::Format::Mvt);
+
+    auto task = source->createTask({301, 384, 10});
+    auto& binaryTask = static_cast<BinaryTileTask&>(*task);
+    binaryTask.rawTileData = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(tile_file));
+
+    auto tileData = source->parse(*task);
+    if (!tileData) {
+        LOGE("Invalid tile file '%s'", tile_file);
+        exit(-1);
+    }
+    for (auto& layer : tileData->layers) {
+        for (auto& feature : layer.features) {
+            polygons.insert(polygons.end(), feature.polygons.begin(), feature.polygons.end());
+        }
+    }
+    return polygons;
+}
+
+struct PosNormColVertex {
+    glm::vec3 pos;
+    glm::vec3 norm;
+    glm::vec2 texcoord;
+    GLuint abgr;
+};
+
+static void BM_Tangram_BuildTilePolygons(benchmark::State& state) {
+    const auto& polygons = tilePolygons();
+    std::vector<PosNormColVertex> vertices;
+    PolygonBuilder builder;
+
+    while(state.KeepRunning()) {
+        for (auto& polygon : polygons) {
+            Builders::buildPolygon(polygon, 0.f, builder,
+                [&](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+                    vertices.push_back({ coord, normal, uv, 0xffffff });
+                });
+            builder.clear();
+        }
+        vertices.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+BENCHMARK(BM_Tangram_BuildTilePolygons);
+
+static void BM_Tangram_TriangulateTilePolygons(benchmark::State& state) {
+    const auto& polygons = tilePolygons();
+    PolygonBuilder builder;
+
+    while(state.KeepRunning()) {
+        for (auto& polygon : polygons) {
+            if (polygon.size() != 1 ||
+                !Builders::triangulateConvex(polygon[0], builder.earcut.indices)) {
+                builder.earcut(polygon);
+            }
+            benchmark::DoNotOptimize(builder.earcut.indices.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+BENCHMARK(BM_Tangram_TriangulateTilePolygons);
+
+// Triangulation of all polygons by earcut, as before convex rings were handled directly
+static void BM_Tangram_EarcutTilePolygons(benchmark::State& state) {
+    const auto& polygons = tilePolygons();
+    PolygonBuilder builder;
+
+    while(state.KeepRunning()) {
+        for (auto& polygon : polygons) {
+            builder.earcut(polygon);
+            benchmark::DoNotOptimize(builder.earcut.indices.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+BENCHMARK(BM_Tangram_EarcutTilePolygons);
+
 BENCHMARK_MAIN();
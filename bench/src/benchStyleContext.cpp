@@ -10,6 +10,7 @@
 #include "scene/importer.h"
 #include "scene/scene.h"
 #include "scene/dataLayer.h"
+#include "scene/nativeFunction.h"
 #include "scene/sceneLayer.h"
 #include "scene/sceneLoader.h"
 #include "text/fontContext.h"
@@ -152,6 +153,94 @@ struct JSTileStyleFnFixture : public benchmark::Fixture {
 
 RUN(JSTileStyleFnFixture, TileStyleFnBench);
 
+// Evaluates the filters of all scene layers for each feature of the tile,
+// either by walking the Filter trees or by running the compiled FilterPrograms
+template<bool compiled>
+struct FilterEvalFixture : public benchmark::Fixture {
+    StyleContext ctx;
+    uint32_t matchCnt = 0;
+
+    void SetUp(const ::benchmark::State& state) override {
+        globalSetup();
+        ctx.initFunctions(*scene);
+        ctx.setZoom(10);
+    }
+    void TearDown(const ::benchmark::State& state) override {
+        LOG(">>> %d", matchCnt);
+    }
+    bool eval(const SceneLayer& layer, const Feature& feat) {
+        return compiled
+            ? layer.filterProgram().eval(feat, ctx)
+            : layer.filter().eval(feat, ctx);
+    }
+    void match(const SceneLayer& layer, const Feature& feat) {
+        if (!eval(layer, feat)) { return; }
+        matchCnt++;
+        for (const auto& sublayer : layer.sublayers()) {
+            match(sublayer, feat);
+        }
+    }
+    __attribute__ ((noinline)) void run() {
+        for (const auto& datalayer : scene->layers()) {
+            for (const auto& collection : tileData->layers) {
+                if (!collection.name.empty()) {
+                    const auto& dlc = datalayer.collections();
+                    bool layerContainsCollection =
+                        std::find(dlc.begin(), dlc.end(), collection.name) != dlc.end();
+
+                    if (!layerContainsCollection) { continue; }
+                }
+                for (const auto& feat : collection.features) {
+                    ctx.setFeature(feat);
+                    match(datalayer, feat);
+                }
+            }
+        }
+    }
+};
+
+using FilterTreeFixture = FilterEvalFixture<false>;
+RUN(FilterTreeFixture, FilterTreeBench);
+
+using FilterProgramFixture = FilterEvalFixture<true>;
+RUN(FilterProgramFixture, FilterProgramBench);
+
+// Evaluates a simple filter function natively or with the JSContext
+template<bool native>
+struct SimpleFunctionFixture : public benchmark::Fixture {
+    const char* source = "function() { return feature.height > 20 && $zoom > 15; }";
+    StyleContext ctx;
+    JSContext js;
+    NativeFunction function;
+    Feature feature;
+    void SetUp(const ::benchmark::State& state) override {
+        feature.props.set("height", 30);
+        ctx.setZoom(16);
+        ctx.setFeature(feature);
+        function.compile(source);
+
+        JavaScriptScope<JSContext> jsScope(js);
+        js.setGlobalValue("$zoom", jsScope.newNumber(16));
+        js.setCurrentFeature(&feature);
+        js.setFunction(0, source);
+    }
+    __attribute__ ((noinline)) void run() {
+        bool result = false;
+        if (native) {
+            function.eval(feature, ctx, result);
+        } else {
+            result = js.evaluateBooleanFunction(0);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+};
+
+using NativeFunctionFixture = SimpleFunctionFixture<true>;
+RUN(NativeFunctionFixture, NativeFunctionBench);
+
+using JSFunctionFixture = SimpleFunctionFixture<false>;
+RUN(JSFunctionFixture, JSFunctionBench);
+
 class DirectGetPropertyFixture : public benchmark::Fixture {
 public:
     Feature feature;
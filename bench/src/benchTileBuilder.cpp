@@ -81,7 +81,15 @@ public:
     }
 };
 
-RUN(TileBuilderFixture, TileBuilderBench);
+BENCHMARK_DEFINE_F(TileBuilderFixture, TileBuilderBench)(benchmark::State& st) {
+    while (st.KeepRunning()) { run(); }
+
+    auto& stats = tileBuilder->matchStats();
+    st.SetLabel("rule memo hits " + std::to_string(stats.memoHits) + "/" +
+                std::to_string(stats.features) + ", saved " +
+                std::to_string(stats.savedTime) + "ms");
+}
+BENCHMARK_REGISTER_F(TileBuilderFixture, TileBuilderBench);
 
 
 
@@ -7,6 +7,8 @@
 #include "tile/tile.h"
 #include "tile/tileTask.h"
 
+#include <string>
+
 using namespace Tangram;
 
 const char tile_file[] = "res/tile.mvt";
@@ -44,5 +46,77 @@ BENCHMARK_DEFINE_F(TileSourceFixture, TileSourceBench)(benchmark::State& st) {
 }
 BENCHMARK_REGISTER_F(TileSourceFixture, TileSourceBench);
 
+// Builds a TopoJSON tile of a grid of polygons where every inner border is
+// an arc shared by two neighbouring cells, similar to admin boundary tiles.
+static std::string createTopoJsonGrid(int _cells, int _arcPoints) {
+
+    std::string arcs;
+    auto addArc = [&](int _x, int _y, bool _horizontal) {
+        if (!arcs.empty()) { arcs += ","; }
+        arcs += "[[" + std::to_string(_x * _arcPoints) + "," + std::to_string(_y * _arcPoints) + "]";
+        for (int i = 0; i < _arcPoints; i++) {
+            arcs += _horizontal ? ",[1,0]" : ",[0,1]";
+        }
+        arcs += "]";
+    };
+
+    // Horizontal arcs: (_cells + 1) rows of _cells, then vertical arcs: (_cells + 1) columns of _cells
+    for (int y = 0; y <= _cells; y++) { for (int x = 0; x < _cells; x++) { addArc(x, y, true); } }
+    for (int x = 0; x <= _cells; x++) { for (int y = 0; y < _cells; y++) { addArc(x, y, false); } }
+
+    int vOffset = (_cells + 1) * _cells;
+
+    std::string geometries;
+    for (int y = 0; y < _cells; y++) {
+        for (int x = 0; x < _cells; x++) {
+            int bottom = y * _cells + x;
+            int top = (y + 1) * _cells + x;
+            int left = vOffset + x * _cells + y;
+            int right = vOffset + (x + 1) * _cells + y;
+            if (!geometries.empty()) { geometries += ","; }
+            geometries += "{\"type\":\"Polygon\",\"properties\":{\"kind\":\"region\"},\"arcs\":[[" +
+                std::to_string(bottom) + "," + std::to_string(right) + "," +
+                std::to_string(-1 - top) + "," + std::to_string(-1 - left) + "]]}";
+        }
+    }
+
+    return "{\"type\":\"Topology\",\"transform\":{\"scale\":[0.0001,0.0001],\"translate\":[0,0]},"
+        "\"arcs\":[" + arcs + "],"
+        "\"objects\":{\"boundaries\":{\"type\":\"GeometryCollection\",\"geometries\":[" + geometries + "]}}}";
+}
+
+struct TopoJsonSourceFixture : public benchmark::Fixture {
+    std::shared_ptr<TileSource> source;
+    std::shared_ptr<TileTask> tileTask;
+    std::shared_ptr<TileData> tileData;
+
+    void SetUp(const ::benchmark::State& state) override {
+        Tile tile({0,0,0});
+
+        source = std::make_shared<TileSource>("test", nullptr);
+        source->setFormat(TileSource::Format::TopoJson);
+
+        tileTask = source->createTask(tile.getID());
+
+        auto json = createTopoJsonGrid(64, 32);
+        auto& t = dynamic_cast<BinaryTileTask&>(*tileTask);
+        t.rawTileData = std::make_shared<std::vector<char>>(json.begin(), json.end());
+    }
+    void TearDown(const ::benchmark::State& state) override {
+    }
+};
+BENCHMARK_DEFINE_F(TopoJsonSourceFixture, TopoJsonSourceBench)(benchmark::State& st) {
+    while (st.KeepRunning()) {
+
+        tileData = source->parse(*tileTask);
+
+        if (!tileData || tileData->layers.empty()) {
+            LOGE("Invalid TopoJSON tile");
+            exit(-1);
+        }
+    }
+}
+BENCHMARK_REGISTER_F(TopoJsonSourceFixture, TopoJsonSourceBench);
+
 
 BENCHMARK_MAIN();
@@ -55,12 +55,27 @@ public:
     void addPolygonFeature(Properties&& properties, PolygonBuilder
         && polygon);
 
+    // Add or replace the feature with the client-defined id @_id.
+    // Unlike the functions above, these changes are applied incrementally by
+    // generateTiles(): Only tiles that cover the previous or the new geometry
+    // of the feature are rebuilt.
+    void setPointFeature(uint64_t _id, Properties&& properties, LngLat coordinates);
+
+    void setPolylineFeature(uint64_t _id, Properties&& properties, PolylineBuilder&& polyline);
+
+    void setPolygonFeature(uint64_t _id, Properties&& properties, PolygonBuilder&& polygon);
+
+    // Remove the feature with the client-defined id @_id.
+    void removeFeature(uint64_t _id);
+
     // Remove all feature data.
     void clearFeatures();
 
     // Transform added feature data into tiles.
     void generateTiles();
 
+    bool isOutdated(const TileID& _tileId, int64_t _generation) const override;
+
     void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override;
     std::shared_ptr<TileTask> createTask(TileID _tileId) override;
 
@@ -73,7 +88,11 @@ protected:
     struct Storage;
     std::unique_ptr<Storage> m_store;
 
+    // Guards m_store, parse() only reads the latest published snapshot
     mutable std::mutex m_mutexStore;
+
+    struct Snapshot;
+    std::shared_ptr<const Snapshot> m_snapshot;
     bool m_hasPendingData = false;
     bool m_generateCentroids = false;
 
@@ -119,6 +119,11 @@ public:
     /* Generation ID of TileSource state (incremented for each update, e.g. on clearData()) */
     int64_t generation() const { return m_generation; }
 
+    /* Whether a tile with @_tileId built at @_generation of this TileSource must be rebuilt */
+    virtual bool isOutdated(const TileID& _tileId, int64_t _generation) const {
+        return _generation < m_generation;
+    }
+
     const ZoomOptions& zoomOptions() { return m_zoomOptions; }
     int32_t minDisplayZoom() const { return m_zoomOptions.minDisplayZoom; }
     int32_t maxDisplayZoom() const { return m_zoomOptions.maxDisplayZoom; }
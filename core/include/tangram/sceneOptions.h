@@ -58,8 +58,13 @@ public:
     /// 16MB default in-memory DataSource cache
     size_t memoryTileCacheSize = CACHE_SIZE;
 
+    /// 32MB default of raster textures kept per raster source. Uploaded
+    /// textures keep their GL texture, not their decoded pixel data.
+    size_t rasterTextureCacheSize = TEXTURE_CACHE_SIZE;
+
 private:
     static constexpr size_t CACHE_SIZE = 16 * (1024 * 1024);
+    static constexpr size_t TEXTURE_CACHE_SIZE = 32 * (1024 * 1024);
 
 };
 
@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "tile/tileTask.h"
 #include "util/geom.h"
+#include "util/mapProjection.h"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
 #include "tile/tile.h"
@@ -16,7 +17,10 @@
 #include <mapbox/geojson_impl.hpp>
 
 
+#include <atomic>
+#include <limits>
 #include <regex>
+#include <unordered_map>
 
 namespace Tangram {
 
@@ -34,10 +38,81 @@ geojsonvt::Options options() {
     return opt;
 }
 
-struct ClientDataSource::Storage {
+// Marks the id of a centroid feature generated for the polygon in the slot given by the other bits
+static constexpr uint64_t centroidFlag = uint64_t(1) << 63;
+
+// Minimum number of incrementally added slots before the main index is rebuilt
+static constexpr size_t minCompactionSize = 1024;
+
+// Number of recent changes that are tracked to invalidate individual tiles
+static constexpr size_t maxTrackedChanges = 1024;
+
+// Immutable geojson-vt index over a range of feature slots
+struct FeatureIndex {
     std::unique_ptr<geojsonvt::GeoJSONVT> tiles;
+    // Properties of the indexed slots, starting at slot 'offset'
+    std::vector<Properties> properties;
+    size_t offset = 0;
+    // geojson-vt slices tiles lazily on first access, this only guards getTile()
+    mutable std::mutex tileMutex;
+};
+
+// Feature data read by parse(). Snapshots are never modified once published,
+// generateTiles() publishes a new one that shares unchanged indices.
+struct ClientDataSource::Snapshot {
+    // Index over the features at the time of the last full build
+    std::shared_ptr<const FeatureIndex> base;
+    // Index over the features added by set*Feature() since the last full build
+    std::shared_ptr<const FeatureIndex> updates;
+    // Slots of 'base' features that were replaced or removed since the last full build
+    std::vector<bool> removed;
+
+    void addFeatures(const FeatureIndex& _index, const TileID& _tileId, int32_t _sourceId, Layer& _layer) const;
+};
+
+// Feature data modified by the add/set functions and generateTiles(), guarded by m_mutexStore
+struct ClientDataSource::Storage {
+
+    // The feature id is the slot index into 'features' and 'removed'
     geometry::feature_collection<double> features;
+    // Slots of features that were replaced or removed since the last full build
+    std::vector<bool> removed;
+    // Number of slots indexed in 'base', later slots are indexed in 'updates'
+    size_t indexedSlots = 0;
+
+    std::shared_ptr<const FeatureIndex> base;
+    std::shared_ptr<const FeatureIndex> updates;
+
+    // Properties of slots that are not indexed in 'base', starting at slot 'indexedSlots'
     std::vector<Properties> properties;
+
+    // Slots of features with a client-defined id
+    std::unordered_map<uint64_t, uint64_t> slots;
+
+    struct Update {
+        uint64_t id;
+        // Null when the feature is removed
+        std::unique_ptr<geometry::feature<double>> feature;
+        Properties properties;
+    };
+    // Incremental updates to be applied on generateTiles()
+    std::vector<Update> pendingUpdates;
+
+    // Whether features were added in bulk or cleared since the last generateTiles()
+    bool needsRebuild = false;
+
+    // Bounds in projected meters and source generation of incremental changes
+    std::vector<std::pair<BoundingBox, int64_t>> changes;
+    // Tiles built before this generation are outdated regardless of 'changes'
+    int64_t rebuildGeneration = 0;
+
+    std::shared_ptr<FeatureIndex> buildIndex(size_t _begin, size_t _end, bool _generateCentroids) const;
+
+    // Drop removed slots and renumber the remaining features. Afterwards no
+    // slots are indexed and 'properties' holds the properties of all features.
+    void compact();
+
+    std::shared_ptr<const Snapshot> snapshot() const;
 };
 
 struct ClientDataSource::PolylineBuilderData : mapbox::geometry::line_string<double> {
@@ -174,26 +249,204 @@ struct prop_visitor {
     }
 };
 
+struct add_bounds {
+
+    BoundingBox& bounds;
+
+    void operator()(const geometry::point<double>& pt) {
+        auto meters = MapProjection::lngLatToProjectedMeters({pt.x, pt.y});
+        bounds.expand(meters.x, meters.y);
+    }
+
+    void operator()(const geometry::geometry<double>& geom) {
+        geometry::geometry<double>::visit(geom, *this);
+    }
+
+    template <typename T>
+    void operator()(const std::vector<T>& geom) {
+        for (auto& g : geom) { (*this)(g); }
+    }
+};
+
+static BoundingBox featureBounds(const geometry::feature<double>& _feature) {
+    BoundingBox bounds{ glm::dvec2(std::numeric_limits<double>::max()),
+                        glm::dvec2(std::numeric_limits<double>::lowest()) };
+    geometry::geometry<double>::visit(_feature.geometry, add_bounds{ bounds });
+    return bounds;
+}
+
+std::shared_ptr<FeatureIndex> ClientDataSource::Storage::buildIndex(size_t _begin, size_t _end,
+                                                                    bool _generateCentroids) const {
+
+    geometry::feature_collection<double> indexFeatures;
+    indexFeatures.reserve(_end - _begin);
+
+    for (size_t slot = _begin; slot < _end; slot++) {
+        if (removed[slot]) { continue; }
+
+        const auto& feat = features[slot];
+        indexFeatures.push_back(feat);
+
+        geometry::point<double> centroid;
+        if (_generateCentroids &&
+            geometry::geometry<double>::visit(feat.geometry, add_centroid{ centroid })) {
+            indexFeatures.emplace_back(centroid, uint64_t(slot) | centroidFlag);
+        }
+    }
+
+    if (indexFeatures.empty()) { return nullptr; }
+
+    auto index = std::make_shared<FeatureIndex>();
+    index->tiles = std::make_unique<geojsonvt::GeoJSONVT>(indexFeatures, options());
+    index->offset = _begin;
+    return index;
+}
+
+void ClientDataSource::Storage::compact() {
+
+    std::vector<uint64_t> remap(features.size());
+    std::vector<Properties> compacted;
+    compacted.reserve(features.size());
+    size_t count = 0;
+
+    for (size_t slot = 0; slot < features.size(); slot++) {
+        if (removed[slot]) { continue; }
+        remap[slot] = count;
+        if (slot != count) {
+            features[count] = std::move(features[slot]);
+        }
+        features[count].id = uint64_t(count);
+        if (slot < indexedSlots) {
+            compacted.push_back(base->properties[slot]);
+        } else {
+            compacted.push_back(std::move(properties[slot - indexedSlots]));
+        }
+        count++;
+    }
+
+    features.resize(count);
+    removed.assign(count, false);
+    properties = std::move(compacted);
+    indexedSlots = 0;
+    base.reset();
+    updates.reset();
+
+    for (auto& it : slots) { it.second = remap[it.second]; }
+}
+
+std::shared_ptr<const ClientDataSource::Snapshot> ClientDataSource::Storage::snapshot() const {
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->base = base;
+    snapshot->updates = updates;
+    snapshot->removed.assign(removed.begin(), removed.begin() + indexedSlots);
+    return snapshot;
+}
+
 void ClientDataSource::generateTiles() {
 
     std::lock_guard<std::mutex> lock(m_mutexStore);
 
-    if (m_generateCentroids) {
-        for (const auto &feat : m_store->features) {
-            geometry::point<double> centroid;
-            const auto& properties = m_store->properties[feat.id.get<uint64_t>()];
-            if (geometry::geometry<double>::visit(feat.geometry, add_centroid{ centroid })) {
-                uint64_t id = m_store->features.size();
-                m_store->features.emplace_back(centroid, id);
-                m_store->properties.push_back(properties);
-                auto& props = m_store->properties.back();
-                props.set("label_placement", 1.0);
+    auto& store = *m_store;
+
+    // Apply incremental updates, collecting the bounds of changed geometry
+    std::vector<BoundingBox> changedBounds;
+
+    for (auto& update : store.pendingUpdates) {
+
+        auto it = store.slots.find(update.id);
+        if (it != store.slots.end()) {
+            uint64_t slot = it->second;
+            changedBounds.push_back(featureBounds(store.features[slot]));
+
+            if (!update.feature) {
+                store.removed[slot] = true;
+                store.slots.erase(it);
+                continue;
             }
+            if (slot >= store.indexedSlots) {
+                // Not yet in the main index: Replace in place
+                update.feature->id = slot;
+                changedBounds.push_back(featureBounds(*update.feature));
+                store.features[slot] = std::move(*update.feature);
+                store.properties[slot - store.indexedSlots] = std::move(update.properties);
+                continue;
+            }
+            store.removed[slot] = true;
+
+        } else if (!update.feature) {
+            continue;
+        }
+
+        uint64_t slot = store.features.size();
+        update.feature->id = slot;
+        changedBounds.push_back(featureBounds(*update.feature));
+        store.features.push_back(std::move(*update.feature));
+        store.properties.push_back(std::move(update.properties));
+        store.removed.push_back(false);
+        store.slots[update.id] = slot;
+    }
+    store.pendingUpdates.clear();
+
+    size_t updatedSlots = store.features.size() - store.indexedSlots;
+
+    if (store.needsRebuild || updatedSlots > std::max(minCompactionSize, store.indexedSlots / 4)) {
+        // Rebuild the main index, this does not change the content of existing tiles
+        store.compact();
+        auto index = store.buildIndex(0, store.features.size(), m_generateCentroids);
+        if (index) { index->properties = std::move(store.properties); }
+        store.properties.clear();
+        store.base = std::move(index);
+        store.indexedSlots = store.features.size();
+
+    } else if (!changedBounds.empty()) {
+        auto index = store.buildIndex(store.indexedSlots, store.features.size(), m_generateCentroids);
+        if (index) { index->properties = store.properties; }
+        store.updates = std::move(index);
+    }
+
+    if (store.needsRebuild || !changedBounds.empty()) {
+        // Publish the new state for parse()
+        std::atomic_store(&m_snapshot, store.snapshot());
+    }
+
+    if (store.needsRebuild) {
+        m_generation++;
+        store.rebuildGeneration = m_generation;
+        store.changes.clear();
+
+    } else if (!changedBounds.empty()) {
+        m_generation++;
+        for (auto& bounds : changedBounds) {
+            store.changes.emplace_back(bounds, m_generation);
+        }
+        if (store.changes.size() > maxTrackedChanges) {
+            // Forget the oldest changes: Tiles built before the last forgotten
+            // change are considered outdated
+            auto end = store.changes.end() - maxTrackedChanges / 2;
+            store.rebuildGeneration = std::max(store.rebuildGeneration, (end - 1)->second);
+            store.changes.erase(store.changes.begin(), end);
         }
     }
 
-    m_store->tiles = std::make_unique<geojsonvt::GeoJSONVT>(m_store->features, options());
-    m_generation++;
+    store.needsRebuild = false;
+}
+
+bool ClientDataSource::isOutdated(const TileID& _tileId, int64_t _generation) const {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    if (_generation >= m_generation) { return false; }
+    if (_generation < m_store->rebuildGeneration) { return true; }
+
+    auto tileBounds = MapProjection::tileBounds(_tileId);
+
+    for (const auto& change : m_store->changes) {
+        if (change.second > _generation && change.first.intersects(tileBounds)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void ClientDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
@@ -218,6 +471,13 @@ void ClientDataSource::clearFeatures() {
 
     m_store->features.clear();
     m_store->properties.clear();
+    m_store->removed.clear();
+    m_store->indexedSlots = 0;
+    m_store->base.reset();
+    m_store->updates.reset();
+    m_store->slots.clear();
+    m_store->pendingUpdates.clear();
+    m_store->needsRebuild = true;
 }
 
 void ClientDataSource::addData(const std::string& _data) {
@@ -227,9 +487,11 @@ void ClientDataSource::addData(const std::string& _data) {
     const auto json = geojson::parse(_data);
     auto features = geojsonvt::geojson::visit(json, geojsonvt::ToFeatureCollection{});
 
+    uint64_t slot = m_store->features.size();
+
     for (auto& feature : features) {
 
-        feature.id = uint64_t(m_store->properties.size());
+        feature.id = slot++;
         m_store->properties.emplace_back();
         Properties& props = m_store->properties.back();
 
@@ -244,6 +506,8 @@ void ClientDataSource::addData(const std::string& _data) {
     m_store->features.insert(m_store->features.end(),
                              std::make_move_iterator(features.begin()),
                              std::make_move_iterator(features.end()));
+    m_store->removed.resize(m_store->features.size(), false);
+    m_store->needsRebuild = true;
 }
 
 void ClientDataSource::addPointFeature(Properties&& properties, LngLat coordinates) {
@@ -255,6 +519,8 @@ void ClientDataSource::addPointFeature(Properties&& properties, LngLat coordinat
     uint64_t id = m_store->features.size();
     m_store->features.emplace_back(geom, id);
     m_store->properties.emplace_back(properties);
+    m_store->removed.push_back(false);
+    m_store->needsRebuild = true;
 }
 
 void ClientDataSource::addPolylineFeature(Properties&& properties, PolylineBuilder&& polyline) {
@@ -265,6 +531,8 @@ void ClientDataSource::addPolylineFeature(Properties&& properties, PolylineBuild
     auto geom = std::move(polyline.data);
     m_store->features.emplace_back(*geom, id);
     m_store->properties.emplace_back(properties);
+    m_store->removed.push_back(false);
+    m_store->needsRebuild = true;
 }
 
 void ClientDataSource::addPolygonFeature(Properties&& properties, PolygonBuilder&& polygon) {
@@ -275,6 +543,43 @@ void ClientDataSource::addPolygonFeature(Properties&& properties, PolygonBuilder
     auto geom = std::move(polygon.data);
     m_store->features.emplace_back(*geom, id);
     m_store->properties.emplace_back(properties);
+    m_store->removed.push_back(false);
+    m_store->needsRebuild = true;
+}
+
+void ClientDataSource::setPointFeature(uint64_t _id, Properties&& properties, LngLat coordinates) {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    geometry::point<double> geom {coordinates.longitude, coordinates.latitude};
+
+    auto feature = std::make_unique<geometry::feature<double>>(geom, _id);
+    m_store->pendingUpdates.push_back({ _id, std::move(feature), std::move(properties) });
+}
+
+void ClientDataSource::setPolylineFeature(uint64_t _id, Properties&& properties, PolylineBuilder&& polyline) {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    auto geom = std::move(polyline.data);
+    auto feature = std::make_unique<geometry::feature<double>>(*geom, _id);
+    m_store->pendingUpdates.push_back({ _id, std::move(feature), std::move(properties) });
+}
+
+void ClientDataSource::setPolygonFeature(uint64_t _id, Properties&& properties, PolygonBuilder&& polygon) {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    auto geom = std::move(polygon.data);
+    auto feature = std::make_unique<geometry::feature<double>>(*geom, _id);
+    m_store->pendingUpdates.push_back({ _id, std::move(feature), std::move(properties) });
+}
+
+void ClientDataSource::removeFeature(uint64_t _id) {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    m_store->pendingUpdates.push_back({ _id, nullptr, {} });
 }
 
 struct add_geometry {
@@ -341,25 +646,49 @@ struct add_geometry {
     }
 };
 
+void ClientDataSource::Snapshot::addFeatures(const FeatureIndex& _index, const TileID& _tileId,
+                                             int32_t _sourceId, Layer& _layer) const {
+
+    std::unique_lock<std::mutex> lock(_index.tileMutex);
+    // Tiles are kept by geojson-vt and not modified once sliced
+    const auto& tile = _index.tiles->getTile(_tileId.z, _tileId.x, _tileId.y);
+    lock.unlock();
+
+    for (auto& it : tile.features) {
+        auto id = it.id.get<uint64_t>();
+        auto slot = id & ~centroidFlag;
+        if (slot < removed.size() && removed[slot]) { continue; }
+
+        Feature feature(_sourceId);
+
+        if (geometry::geometry<int16_t>::visit(it.geometry, add_geometry{ feature })) {
+            feature.props = _index.properties[slot - _index.offset];
+            if (id & centroidFlag) {
+                feature.props.set("label_placement", 1.0);
+            }
+            _layer.features.emplace_back(std::move(feature));
+        }
+    }
+}
+
 std::shared_ptr<TileData> ClientDataSource::parse(const TileTask& _task) const {
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
+    // Parse without blocking on the UI thread or other workers:
+    // The snapshot stays valid while features are updated
+    auto snapshot = std::atomic_load(&m_snapshot);
 
-    auto data = std::make_shared<TileData>();
+    if (!snapshot || (!snapshot->base && !snapshot->updates)) { return nullptr; }
 
-    if (!m_store->tiles) { return nullptr; }
-    auto tile = m_store->tiles->getTile(_task.tileId().z, _task.tileId().x, _task.tileId().y);
+    auto data = std::make_shared<TileData>();
 
     data->layers.emplace_back("");  // empty name will skip filtering by 'collection'
     Layer& layer = data->layers.back();
 
-    for (auto& it : tile.features) {
-        Feature feature(m_id);
-
-        if (geometry::geometry<int16_t>::visit(it.geometry, add_geometry{ feature })) {
-            feature.props = m_store->properties[it.id.get<uint64_t>()];
-            layer.features.emplace_back(std::move(feature));
-        }
+    if (snapshot->base) {
+        snapshot->addFeatures(*snapshot->base, _task.tileId(), m_id, layer);
+    }
+    if (snapshot->updates) {
+        snapshot->addFeatures(*snapshot->updates, _task.tileId(), m_id, layer);
     }
 
     return data;
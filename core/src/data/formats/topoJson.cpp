@@ -6,6 +6,8 @@
 #include "util/mapProjection.h"
 #include "log.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 TopoJson::Topology TopoJson::getTopology(const JsonDocument& _document, const Transform& _proj) {
@@ -39,6 +41,13 @@ TopoJson::Topology TopoJson::getTopology(const JsonDocument& _document, const Tr
         return topo;
     }
 
+    // Count points first to decode all arcs into a single buffer
+    size_t pointCount = 0;
+    for (auto jsonArcsIt = jsonArcs.Begin(); jsonArcsIt != jsonArcs.End(); ++jsonArcsIt) {
+        if (jsonArcsIt->IsArray()) { pointCount += jsonArcsIt->Size(); }
+    }
+
+    topo.points.reserve(pointCount);
     topo.arcs.reserve(jsonArcs.Size());
 
     // Decode and transform the points that make up 'arcs'
@@ -46,23 +55,25 @@ TopoJson::Topology TopoJson::getTopology(const JsonDocument& _document, const Tr
 
         const auto& jsonArc = *jsonArcsIt;
 
-        if (!jsonArc.IsArray()) { // According to spec, jsonArc.Size() >= 2 should also hold
-            continue;
-        }
+        Arc arc;
+        arc.offset = topo.points.size();
 
-        Line arc;
-        arc.reserve(jsonArc.Size());
+        // Invalid arcs are kept as empty ranges so that arc indices stay valid.
+        // According to spec, jsonArc.Size() >= 2 should also hold
+        if (jsonArc.IsArray()) {
 
-        // Quantized position
-        glm::ivec2 q;
+            // Quantized position
+            glm::ivec2 q;
 
-        for (auto jsonCoordsIt = jsonArc.Begin(); jsonCoordsIt != jsonArc.End(); ++jsonCoordsIt) {
+            for (auto jsonCoordsIt = jsonArc.Begin(); jsonCoordsIt != jsonArc.End(); ++jsonCoordsIt) {
 
-            const auto& jsonCoords = *jsonCoordsIt;
+                const auto& jsonCoords = *jsonCoordsIt;
 
-            arc.push_back(getPoint(jsonCoords, topo, q));
+                topo.points.push_back(getPoint(jsonCoords, topo, q));
+            }
         }
 
+        arc.count = topo.points.size() - arc.offset;
         topo.arcs.push_back(arc);
     }
 
@@ -83,6 +94,24 @@ Point TopoJson::getPoint(const JsonValue& _coordinates, const Topology& _topolog
 
 }
 
+static const TopoJson::Arc* resolveArc(const JsonValue& _index, const TopoJson::Topology& _topology, bool& _reverse) {
+
+    if (!_index.IsInt()) { return nullptr; }
+
+    auto index = _index.GetInt();
+    _reverse = false;
+    if (index < 0) {
+        _reverse = true;
+        index = -1 - index;
+    }
+
+    if (index < 0 || (size_t)index >= _topology.arcs.size()) {
+        return nullptr;
+    }
+
+    return &_topology.arcs[index];
+}
+
 Line TopoJson::getLine(const JsonValue& _arcs, const Topology& _topology) {
 
     Line line;
@@ -91,41 +120,39 @@ Line TopoJson::getLine(const JsonValue& _arcs, const Topology& _topology) {
         return line;
     }
 
+    bool reverse = false;
+
+    size_t pointCount = 0;
     for (auto arcIt = _arcs.Begin(); arcIt != _arcs.End(); ++arcIt) {
+        if (auto arc = resolveArc(*arcIt, _topology, reverse)) { pointCount += arc->count; }
+    }
 
-        auto index = arcIt->GetInt();
-        bool reverse = false;
-        if (index < 0) {
-            reverse = true;
-            index = -1 - index;
-        }
+    line.reserve(pointCount);
 
-        if (index < 0 || (std::vector<Line>::size_type)index >= _topology.arcs.size()) {
-            continue;
-        }
+    for (auto arcIt = _arcs.Begin(); arcIt != _arcs.End(); ++arcIt) {
 
-        const auto& arc = _topology.arcs[index];
+        auto arc = resolveArc(*arcIt, _topology, reverse);
 
-        auto begin = arc.begin();
-        auto end = arc.end();
-        size_t inc = 1;
-        if (reverse) {
-            begin = arc.end() - 1;
-            end = arc.begin() - 1;
-            inc = -inc;
+        if (!arc || arc->count == 0) {
+            continue;
         }
 
         // If a line is made from multiple arcs, the first position of an arc must
         // be equal to the last position of the previous arc. So when reconstructing
         // the geometry, the first position of each arc except the first may be dropped
-        if (arcIt != _arcs.Begin()) {
-            begin = begin + inc;
-        }
+        size_t skip = (arcIt != _arcs.Begin()) ? 1 : 0;
 
-        for (auto pointIt = begin; pointIt != end; pointIt += inc) {
-            line.push_back(*pointIt);
-        }
+        auto begin = _topology.points.begin() + arc->offset;
+        auto end = begin + arc->count;
 
+        if (reverse) {
+            // Copy the range without its last point and reverse it in place
+            size_t start = line.size();
+            line.insert(line.end(), begin, end - skip);
+            std::reverse(line.begin() + start, line.end());
+        } else {
+            line.insert(line.end(), begin + skip, end);
+        }
     }
 
     return line;
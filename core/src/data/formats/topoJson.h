@@ -16,10 +16,19 @@ namespace TopoJson {
 
 using Transform = std::function<Point(LngLat _lngLat)>;
 
+// Range of an arc's decoded points within Topology::points
+struct Arc {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
 struct Topology {
     glm::dvec2 scale = { 1., 1. };
     glm::dvec2 translate = { 0., 0. };
-    std::vector<Line> arcs;
+    // Decoded and projected points of all arcs, stored contiguously so that
+    // arcs shared between geometries are only decoded once per tile
+    std::vector<Point> points;
+    std::vector<Arc> arcs;
     Transform proj;
 };
 
@@ -1,14 +1,81 @@
 #include "data/rasterSource.h"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
+#include "scene/scene.h"
 #include "tile/tile.h"
 #include "tile/tileBuilder.h"
 #include "tile/tileTask.h"
 #include "util/mapProjection.h"
 #include "log.h"
 
+#include <cmath>
+#include <list>
+#include <unordered_map>
+
 namespace Tangram {
 
+// Number of zoom levels to search upwards for a cached parent raster
+static constexpr int maxParentLevels = 4;
+
+struct RasterSource::TextureCache {
+    // Guards all members: Textures are cached from worker threads and
+    // released from wherever the last tile holding them is destroyed.
+    std::mutex mutex;
+
+    // Decoded textures that are in use by tiles or kept in 'recent'
+    std::map<TileID, std::weak_ptr<Texture>> textures;
+
+    // Recently used textures, most recent first. These are kept alive
+    // until their accumulated size exceeds 'maxUsage'. Uploaded textures
+    // have disposed their pixel data, so this keeps the GL textures, which
+    // are drawn again without decoding or uploading.
+    using RecentList = std::list<std::pair<TileID, std::shared_ptr<Texture>>>;
+    RecentList recent;
+    std::unordered_map<TileID, RecentList::iterator> recentEntries;
+
+    size_t usage = 0;
+    size_t maxUsage = 0;
+
+    // Returns the texture for _id and marks it as recently used.
+    // Evicted textures are moved to _evicted so that they can be
+    // released after the lock is given up.
+    std::shared_ptr<Texture> get(const TileID& _id, std::vector<std::shared_ptr<Texture>>& _evicted) {
+        auto it = textures.find(_id);
+        if (it == textures.end()) { return nullptr; }
+
+        auto texture = it->second.lock();
+        if (texture) { touch(_id, texture, _evicted); }
+        return texture;
+    }
+
+    void touch(const TileID& _id, const std::shared_ptr<Texture>& _texture,
+               std::vector<std::shared_ptr<Texture>>& _evicted) {
+
+        auto it = recentEntries.find(_id);
+        if (it != recentEntries.end()) {
+            recent.splice(recent.begin(), recent, it->second);
+            return;
+        }
+        if (maxUsage == 0) { return; }
+
+        recent.emplace_front(_id, _texture);
+        recentEntries.emplace(_id, recent.begin());
+        usage += _texture->bufferSize();
+
+        limit(_evicted);
+    }
+
+    void limit(std::vector<std::shared_ptr<Texture>>& _evicted) {
+        while (usage > maxUsage && !recent.empty()) {
+            auto& entry = recent.back();
+            usage -= entry.second->bufferSize();
+            recentEntries.erase(entry.first);
+            _evicted.push_back(std::move(entry.second));
+            recent.pop_back();
+        }
+    }
+};
+
 class RasterTileTask : public BinaryTileTask {
 public:
 
@@ -17,6 +84,18 @@ public:
     std::unique_ptr<Texture> texture;
     std::unique_ptr<Raster> raster;
 
+    // Set when 'raster' is a parent raster that is used until the
+    // texture of this task is decoded
+    std::shared_ptr<Raster> loading;
+
+    // Publish the parent raster when the texture could not be loaded, so
+    // that tiles stop waiting for it. Nothing is cached for this tile, so
+    // its raster is requested again when the tile is rebuilt.
+    void loadingFailed() {
+        loading->tileID = raster->tileID;
+        std::atomic_store(&loading->texture, raster->texture);
+    }
+
     RasterTileTask(TileID& _tileId, std::shared_ptr<TileSource> _source, bool _subTask)
         : BinaryTileTask(_tileId, _source),
           subTask(_subTask) {}
@@ -33,6 +112,9 @@ public:
     bool isReady() const override {
         if (!subTask) {
             return bool(m_tile);
+        } else if (loading && rawTileData) {
+            // Wait for loaded data to be decoded instead of using the parent
+            return m_ready;
         } else {
             return bool(texture) || bool(raster);
         }
@@ -42,9 +124,22 @@ public:
         auto source = rasterSource();
         if (!source) { return; }
 
-        if (!texture && !raster) {
+        float pixelScale = _tileBuilder.scene().pixelScale();
+
+        if (loading) {
+            // Decode texture data and pass it on to tiles that already
+            // sample the parent raster
+            if (auto tex = source->createTexture(m_tileId, *rawTileData, pixelScale)) {
+                std::atomic_store(&loading->texture,
+                                  source->cacheTexture(m_tileId, std::move(tex)));
+            } else {
+                loadingFailed();
+            }
+            m_ready = true;
+
+        } else if (!texture && !raster) {
             // Decode texture data
-            texture = source->createTexture(m_tileId, *rawTileData);
+            texture = source->createTexture(m_tileId, *rawTileData, pixelScale);
             if (!texture) {
                 raster = std::make_unique<Raster>(m_tileId, source->emptyTexture());
             }
@@ -63,7 +158,14 @@ public:
 
         auto& rasters = _tile.rasters();
 
-        if (raster) {
+        if (loading) {
+            if (auto tex = std::atomic_load(&loading->texture)) {
+                rasters.emplace_back(loading->tileID, tex);
+            } else {
+                rasters.emplace_back(raster->tileID, raster->texture);
+                rasters.back().loading = loading;
+            }
+        } else if (raster) {
             rasters.emplace_back(raster->tileID, raster->texture);
         } else {
             auto tex = source->cacheTexture(m_tileId, std::move(texture));
@@ -92,7 +194,7 @@ RasterSource::RasterSource(const std::string& _name, std::unique_ptr<DataSource>
     : TileSource(_name, std::move(_sources), _zoomOptions),
       m_texOptions(_options) {
 
-    m_textures = std::make_shared<Cache>();
+    m_textures = std::make_shared<TextureCache>();
     m_emptyTexture = std::make_shared<Texture>(m_texOptions);
 
     GLubyte pixel[4] = { 0, 0, 0, 0 };
@@ -121,22 +223,48 @@ void RasterSource::generateGeometry(bool _generateGeometry) {
     }
 }
 
-std::unique_ptr<Texture> RasterSource::createTexture(TileID _tile, const std::vector<char>& _rawTileData) {
+void RasterSource::setCacheSize(size_t _cacheSize) {
+    std::vector<std::shared_ptr<Texture>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_textures->mutex);
+        m_textures->maxUsage = _cacheSize;
+        m_textures->limit(evicted);
+    }
+}
+
+std::unique_ptr<Texture> RasterSource::createTexture(TileID _tile, const std::vector<char>& _rawTileData,
+                                                     float _pixelScale) {
     if (_rawTileData.empty()) { return nullptr; }
 
     auto data = reinterpret_cast<const uint8_t*>(_rawTileData.data());
     auto length = _rawTileData.size();
 
-    return std::make_unique<Texture>(data, length, m_texOptions);
+    auto texture = std::make_unique<Texture>(data, length, m_texOptions);
+
+    if (m_downsample) {
+        // Keep at least the resolution at which a tile is drawn
+        int size = std::ceil(MapProjection::tileSize() * _pixelScale * (1 << m_zoomOptions.zoomBias));
+        texture->downsample(size);
+    }
+
+    return texture;
 }
 
 void RasterSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
     // TODO, remove this
-    // Overwrite cb to set empty texture on failure
+    // Overwrite cb to set a parent or empty texture on failure
     TileTaskCb cb{[this, _cb](std::shared_ptr<TileTask> _task) {
-        if (!_task->hasData()) {
-            auto& task = static_cast<RasterTileTask&>(*_task);
-            task.raster = std::make_unique<Raster>(task.tileId(), m_emptyTexture);
+        auto& task = static_cast<RasterTileTask&>(*_task);
+        if (task.loading && !task.rawTileData) {
+            task.loadingFailed();
+
+        } else if (!_task->hasData()) {
+            TileID parentId = task.tileId();
+            if (auto texture = parentTexture(task.tileId(), parentId)) {
+                task.raster = std::make_unique<Raster>(parentId, texture);
+            } else {
+                task.raster = std::make_unique<Raster>(task.tileId(), m_emptyTexture);
+            }
         }
         _cb.func(_task);
     }};
@@ -173,21 +301,47 @@ std::shared_ptr<RasterTileTask> RasterSource::createRasterTask(TileID _tileId, b
     // First try existing textures cache
     TileID id(_tileId.x, _tileId.y, _tileId.z);
 
-    auto texIt = m_textures->find(id);
-    if (texIt != m_textures->end()) {
-        auto texture = texIt->second.lock();
-
-        if (texture) {
-            LOGD("%d - reuse %s", m_textures->size(), id.toString().c_str());
+    std::vector<std::shared_ptr<Texture>> evicted;
+    std::shared_ptr<Texture> texture;
+    {
+        std::lock_guard<std::mutex> lock(m_textures->mutex);
+        texture = m_textures->get(id, evicted);
+    }
 
-            task->raster = std::make_unique<Raster>(id, texture);
-            // No more loading needed.
-            task->startedLoading();
+    if (texture) {
+        LOGD("reuse %s", id.toString().c_str());
+
+        task->raster = std::make_unique<Raster>(id, texture);
+        // No more loading needed.
+        task->startedLoading();
+
+    } else if (subTask) {
+        // Let the tile sample a parent raster until this one is decoded,
+        // rather than holding back its geometry.
+        TileID parentId = id;
+        if (auto parent = parentTexture(id, parentId)) {
+            task->raster = std::make_unique<Raster>(parentId, parent);
+            task->loading = std::make_shared<Raster>(id, nullptr);
         }
     }
     return task;
 }
 
+std::shared_ptr<Texture> RasterSource::parentTexture(const TileID& _tileId, TileID& _parentId) {
+    std::vector<std::shared_ptr<Texture>> evicted;
+    std::lock_guard<std::mutex> lock(m_textures->mutex);
+
+    TileID id(_tileId.x, _tileId.y, _tileId.z);
+    for (int i = 0; i < maxParentLevels && id.z > 0; i++) {
+        id = id.getParent();
+        if (auto texture = m_textures->get(id, evicted)) {
+            _parentId = id;
+            return texture;
+        }
+    }
+    return nullptr;
+}
+
 std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId) {
     auto task = createRasterTask(_tileId, false);
 
@@ -199,25 +353,35 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId) {
 std::shared_ptr<Texture> RasterSource::cacheTexture(const TileID& _tileId, std::unique_ptr<Texture> _texture) {
     TileID id(_tileId.x, _tileId.y, _tileId.z);
 
-    auto& textureEntry = (*m_textures)[id];
+    std::vector<std::shared_ptr<Texture>> evicted;
+    std::lock_guard<std::mutex> lock(m_textures->mutex);
+
+    auto& textureEntry = m_textures->textures[id];
     auto texture = textureEntry.lock();
     if (texture) {
-        LOGD("%d - drop duplicate %s", m_textures->size(), id.toString().c_str());
+        LOGD("%d - drop duplicate %s", m_textures->textures.size(), id.toString().c_str());
         // The same texture has been loaded in the meantime: Reuse it and drop _texture..
+        m_textures->touch(id, texture, evicted);
         return texture;
     }
 
     texture = std::shared_ptr<Texture>(_texture.release(),
-                                       [c = std::weak_ptr<Cache>(m_textures), id](auto* t) {
+                                       [c = std::weak_ptr<TextureCache>(m_textures), id](auto* t) {
                                            if (auto cache = c.lock()) {
-                                               cache->erase(id);
-                                               LOGD("%d - remove %s", cache->size(), id.toString().c_str());
+                                               std::lock_guard<std::mutex> lock(cache->mutex);
+                                               auto it = cache->textures.find(id);
+                                               // Keep the entry of a texture that replaced this one
+                                               if (it != cache->textures.end() && it->second.expired()) {
+                                                   cache->textures.erase(it);
+                                               }
+                                               LOGD("%d - remove %s", cache->textures.size(), id.toString().c_str());
                                            }
                                            delete t;
                                        });
     // Add to cache
     textureEntry = texture;
-    LOGD("%d - added %s", m_textures->size(), id.toString().c_str());
+    m_textures->touch(id, texture, evicted);
+    LOGD("%d - added %s", m_textures->textures.size(), id.toString().c_str());
 
     return texture;
 }
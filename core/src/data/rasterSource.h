@@ -15,11 +15,14 @@ class RasterTileTask;
 
 class RasterSource : public TileSource {
 
-    using Cache = std::map<TileID, std::weak_ptr<Texture>>;
-    std::shared_ptr<Cache> m_textures;
+    struct TextureCache;
+    std::shared_ptr<TextureCache> m_textures;
 
     TextureOptions m_texOptions;
 
+    // Reduce decoded textures to the resolution at which they are displayed
+    bool m_downsample = false;
+
     std::shared_ptr<Texture> m_emptyTexture;
 
     friend class RasterTileTask;
@@ -33,10 +36,15 @@ protected:
 
     void addRasterTask(TileTask& _tileTask);
 
-    std::unique_ptr<Texture> createTexture(TileID _tile, const std::vector<char>& _rawTileData);
+    std::unique_ptr<Texture> createTexture(TileID _tile, const std::vector<char>& _rawTileData,
+                                           float _pixelScale = 1.f);
 
     std::shared_ptr<Texture> cacheTexture(const TileID& _tileId, std::unique_ptr<Texture> _texture);
 
+    // Returns the nearest cached texture of a parent of _tileId, with the
+    // parent's TileID in _parentId
+    std::shared_ptr<Texture> parentTexture(const TileID& _tileId, TileID& _parentId);
+
     std::shared_ptr<Texture> emptyTexture() { return m_emptyTexture; }
 
 public:
@@ -55,6 +63,13 @@ public:
 
     void generateGeometry(bool _generateGeometry) override;
 
+    // Set the number of bytes of textures that are kept for reuse after no
+    // tile uses them anymore. Pixel data is not kept once a texture has
+    // been uploaded, only its GL texture.
+    void setCacheSize(size_t _cacheSize);
+
+    void setDownsampling(bool _downsample) { m_downsample = _downsample; }
+
 };
 
 }
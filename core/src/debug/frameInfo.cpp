@@ -4,6 +4,7 @@
 #include "gl.h"
 #include "gl/glError.h"
 #include "gl/primitives.h"
+#include "gl/renderState.h"
 #include "map.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
@@ -55,6 +56,9 @@ void FrameInfo::beginFrame() {
 void FrameInfo::draw(RenderState& rs, const View& _view, const TileManager& _tileManager) {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
+        // State changes of the frame, before drawing the debug infos
+        auto frameStats = rs.frameStats();
+
         static int cpt = 0;
 
         static std::deque<float> updatetime;
@@ -120,6 +124,17 @@ void FrameInfo::draw(RenderState& rs, const View& _view, const TileManager& _til
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
+            debuginfos.push_back("program binds:" + std::to_string(frameStats.programBinds));
+            debuginfos.push_back("texture binds:" + std::to_string(frameStats.textureBinds));
+            debuginfos.push_back("state changes:" + std::to_string(frameStats.stateChanges));
+            debuginfos.push_back("redundant states:" + std::to_string(frameStats.redundantStates));
+
+            auto poolStats = rs.poolStats();
+            debuginfos.push_back("texture pool hits:" + std::to_string(poolStats.textureHits) + "/"
+                                 + std::to_string(poolStats.textureHits + poolStats.textureMisses));
+            debuginfos.push_back("buffer pool hits:" + std::to_string(poolStats.bufferHits) + "/"
+                                 + std::to_string(poolStats.bufferHits + poolStats.bufferMisses));
+            debuginfos.push_back("pending deletions:" + std::to_string(rs.pendingDeletions()));
             debuginfos.push_back("zoom:" + std::to_string(_view.getZoom()));
             debuginfos.push_back("pos:" + std::to_string(_view.getPosition().x) + "/"
                                  + std::to_string(_view.getPosition().y));
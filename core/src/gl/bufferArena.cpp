@@ -0,0 +1,157 @@
+#include "gl/bufferArena.h"
+#include "gl/renderState.h"
+
+#include <algorithm>
+
+namespace Tangram {
+
+BufferArena::BufferArena(GLenum _target, GLsizeiptr _pageSize)
+    : m_target(_target),
+      m_pageSize(_pageSize) {}
+
+BufferArena::Allocation BufferArena::allocate(RenderState& rs, GLsizeiptr _size,
+                                              const GLvoid* _data) {
+    Allocation allocation;
+    if (_size <= 0) { return allocation; }
+
+    GLsizeiptr size = (_size + alignment - 1) / alignment * alignment;
+
+    auto it = std::find_if(m_pages.begin(), m_pages.end(),
+                           [&](Page& page) { return allocate(page, size, allocation); });
+
+    if (it == m_pages.end()) {
+        Page page;
+        page.id = m_nextPageId++;
+        page.size = std::max(size, m_pageSize);
+        page.freeRanges.push_back({ 0, page.size });
+        GL::genBuffers(1, &page.buffer);
+
+        if (m_target == GL_ARRAY_BUFFER) {
+            rs.vertexBuffer(page.buffer);
+        } else {
+            rs.indexBuffer(page.buffer);
+        }
+        GL::bufferData(m_target, page.size, nullptr, GL_STATIC_DRAW);
+
+        m_pages.push_back(std::move(page));
+        allocate(m_pages.back(), size, allocation);
+    }
+
+    if (m_target == GL_ARRAY_BUFFER) {
+        rs.vertexBuffer(allocation.buffer);
+    } else {
+        rs.indexBuffer(allocation.buffer);
+    }
+    GL::bufferSubData(m_target, allocation.offset, _size, _data);
+
+    return allocation;
+}
+
+bool BufferArena::allocate(Page& _page, GLsizeiptr _size, Allocation& _allocation) {
+
+    // First fit
+    for (auto it = _page.freeRanges.begin(); it != _page.freeRanges.end(); ++it) {
+        if (it->size < _size) { continue; }
+
+        _allocation.buffer = _page.buffer;
+        _allocation.page = _page.id;
+        _allocation.offset = it->offset;
+        _allocation.size = _size;
+
+        it->offset += _size;
+        it->size -= _size;
+        if (it->size == 0) { _page.freeRanges.erase(it); }
+        return true;
+    }
+    return false;
+}
+
+void BufferArena::release(Page& _page, const Range& _range) {
+    auto& ranges = _page.freeRanges;
+
+    auto next = std::lower_bound(ranges.begin(), ranges.end(), _range.offset,
+                                 [](const Range& r, GLintptr offset) { return r.offset < offset; });
+
+    // Merge with the adjacent free ranges
+    bool mergePrev = (next != ranges.begin() &&
+                      (next - 1)->offset + (next - 1)->size == _range.offset);
+    bool mergeNext = (next != ranges.end() &&
+                      _range.offset + _range.size == next->offset);
+
+    if (mergePrev && mergeNext) {
+        (next - 1)->size += _range.size + next->size;
+        ranges.erase(next);
+    } else if (mergePrev) {
+        (next - 1)->size += _range.size;
+    } else if (mergeNext) {
+        next->offset = _range.offset;
+        next->size += _range.size;
+    } else {
+        ranges.insert(next, _range);
+    }
+}
+
+void BufferArena::free(const Allocation& _allocation) {
+    if (!_allocation) { return; }
+
+    std::lock_guard<std::mutex> lock(m_freeListMutex);
+    m_freeList.push_back(_allocation);
+}
+
+void BufferArena::flush() {
+    std::vector<Allocation> freeList;
+    {
+        std::lock_guard<std::mutex> lock(m_freeListMutex);
+        if (m_freeList.empty()) { return; }
+        freeList.swap(m_freeList);
+    }
+
+    for (auto& allocation : freeList) {
+        auto page = std::find_if(m_pages.begin(), m_pages.end(),
+                                 [&](const Page& p) { return p.id == allocation.page; });
+
+        // The page was dropped by invalidate()
+        if (page == m_pages.end()) { continue; }
+
+        release(*page, { allocation.offset, allocation.size });
+    }
+
+    // Delete empty pages, but keep one for the next allocations
+    bool keep = true;
+    for (auto it = m_pages.begin(); it != m_pages.end();) {
+        if (it->isEmpty() && !(keep && it->size == m_pageSize)) {
+            GL::deleteBuffers(1, &it->buffer);
+            it = m_pages.erase(it);
+        } else {
+            if (it->isEmpty()) { keep = false; }
+            ++it;
+        }
+    }
+}
+
+void BufferArena::invalidate() {
+    m_pages.clear();
+
+    std::lock_guard<std::mutex> lock(m_freeListMutex);
+    m_freeList.clear();
+}
+
+void BufferArena::dispose() {
+    for (auto& page : m_pages) {
+        GL::deleteBuffers(1, &page.buffer);
+    }
+    invalidate();
+}
+
+GLsizeiptr BufferArena::usedBytes() const {
+    GLsizeiptr used = 0;
+    for (auto& page : m_pages) {
+        used += page.size;
+        for (auto& range : page.freeRanges) {
+            used -= range.size;
+        }
+    }
+    return used;
+}
+
+}
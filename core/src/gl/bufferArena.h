@@ -0,0 +1,92 @@
+#pragma once
+
+#include "gl.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class RenderState;
+
+/*
+ * BufferArena - Suballocates static mesh data from a few large GL buffers ('pages')
+ * instead of creating and deleting buffers for each mesh. Freed ranges are returned
+ * to the free list of their page on the next flush() and pages without allocations
+ * are deleted, except for one that is kept for the next allocations.
+ */
+class BufferArena {
+
+public:
+
+    struct Allocation {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+        uint32_t page = 0;
+
+        explicit operator bool() const { return buffer != 0; }
+    };
+
+    // Offsets of allocations are aligned to this number of bytes
+    static constexpr GLsizeiptr alignment = 16;
+
+    // @_target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+    // @_pageSize size of the GL buffers, larger allocations get a page of their own
+    BufferArena(GLenum _target, GLsizeiptr _pageSize);
+
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    // Allocate @_size bytes and upload @_data to them. The buffer of the
+    // returned allocation is bound to the target of the arena.
+    Allocation allocate(RenderState& rs, GLsizeiptr _size, const GLvoid* _data);
+
+    // Queue @_allocation to be reclaimed on the next flush(), may be called from any thread
+    void free(const Allocation& _allocation);
+
+    // Reclaim freed allocations and delete unused pages
+    void flush();
+
+    // Forget all pages without deleting their buffers. Call this after GL context loss.
+    void invalidate();
+
+    // Delete all pages, the arena does not delete them on destruction
+    void dispose();
+
+    size_t pageCount() const { return m_pages.size(); }
+
+    // Number of bytes in use by allocations, including padding
+    GLsizeiptr usedBytes() const;
+
+private:
+
+    struct Range {
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    struct Page {
+        GLuint buffer;
+        uint32_t id;
+        GLsizeiptr size;
+        // Free ranges ordered by offset
+        std::vector<Range> freeRanges;
+
+        bool isEmpty() const { return freeRanges.size() == 1 && freeRanges[0].size == size; }
+    };
+
+    bool allocate(Page& _page, GLsizeiptr _size, Allocation& _allocation);
+    static void release(Page& _page, const Range& _range);
+
+    GLenum m_target;
+    GLsizeiptr m_pageSize;
+    uint32_t m_nextPageId = 1;
+
+    std::vector<Page> m_pages;
+
+    std::mutex m_freeListMutex;
+    std::vector<Allocation> m_freeList;
+};
+
+}
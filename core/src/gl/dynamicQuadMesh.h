@@ -64,13 +64,16 @@ void DynamicQuadMesh<T>::upload(RenderState& rs) {
 
     if (m_nVertices == 0 || m_isUploaded) { return; }
 
-    // Generate vertex buffer, if needed
+    // Get a vertex buffer, if needed
     if (m_glVertexBuffer == 0) {
-        GL::genBuffers(1, &m_glVertexBuffer);
+        m_glVertexBuffer = rs.acquireBuffer(GL_ARRAY_BUFFER,
+                                            m_nVertices * m_vertexLayout->getStride());
     }
 
     MeshBase::subDataUpload(rs, reinterpret_cast<GLbyte*>(m_vertices.data()));
 
+    m_rs = &rs;
+
     m_isUploaded = true;
 }
 
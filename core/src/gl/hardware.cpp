@@ -16,6 +16,7 @@ bool supportsMapBuffer = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
 bool supportsGLRGBA8OES = false;
+bool supportsElementIndexUint = false;
 
 uint32_t maxTextureSize = 0;
 uint32_t maxCombinedTextureUnits = 0;
@@ -56,11 +57,18 @@ void loadExtensions() {
     supportsVAOs = isAvailable("vertex_array_object");
     supportsTextureNPOT = isAvailable("texture_non_power_of_two");
     supportsGLRGBA8OES = isAvailable("rgb8_rgba8");
+    supportsElementIndexUint = isAvailable("element_index_uint");
+
+#if defined(TANGRAM_OSX) || defined(TANGRAM_LINUX) || defined(TANGRAM_WINDOWS)
+    // 32 bit indices are core in desktop OpenGL
+    supportsElementIndexUint = true;
+#endif
 
     LOG("Driver supports map buffer: %d", supportsMapBuffer);
     LOG("Driver supports vaos: %d", supportsVAOs);
     LOG("Driver supports rgb8_rgba8: %d", supportsGLRGBA8OES);
     LOG("Driver supports NPOT texture: %d", supportsTextureNPOT);
+    LOG("Driver supports 32 bit indices: %d", supportsElementIndexUint);
 
     // find extension symbols if needed
     initGLExtensions();
@@ -34,21 +34,35 @@ MeshBase::MeshBase(std::shared_ptr<VertexLayout> _vertexLayout, GLenum _drawMode
 }
 
 MeshBase::~MeshBase() {
+    releaseBuffers();
+}
+
+void MeshBase::releaseBuffers() {
+    if (m_vertexArena) { m_vertexArena->free(m_vertexAllocation); }
+    if (m_indexArena) { m_indexArena->free(m_indexAllocation); }
+
     if (m_rs) {
-        if (m_glVertexBuffer || m_glIndexBuffer) {
-            GLuint buffers[] = { m_glVertexBuffer, m_glIndexBuffer };
-            m_rs->queueBufferDeletion(2, buffers);
+        // Buffers of static meshes are owned by the arenas,
+        // keep the buffers of other meshes for reuse
+        if (!m_vertexArena && m_glVertexBuffer) {
+            m_rs->releaseBuffer(m_glVertexBuffer, GL_ARRAY_BUFFER,
+                                m_nVertices * m_vertexLayout->getStride());
+        }
+        if (!m_indexArena && m_glIndexBuffer) {
+            m_rs->releaseBuffer(m_glIndexBuffer, GL_ELEMENT_ARRAY_BUFFER, m_nIndices * indexSize());
         }
         m_vaos.dispose(*m_rs);
     }
 
-    if (m_glVertexData) {
-        delete[] m_glVertexData;
-    }
-
-    if (m_glIndexData) {
-        delete[] m_glIndexData;
-    }
+    m_vertexArena = nullptr;
+    m_indexArena = nullptr;
+    m_vertexAllocation = {};
+    m_indexAllocation = {};
+    m_glVertexBuffer = 0;
+    m_glIndexBuffer = 0;
+    m_glVertexOffset = 0;
+    m_glIndexOffset = 0;
+    m_isUploaded = false;
 }
 
 void MeshBase::setVertexLayout(std::shared_ptr<VertexLayout> _vertexLayout) {
@@ -109,35 +123,62 @@ void MeshBase::subDataUpload(RenderState& rs, GLbyte* _data) {
 
 void MeshBase::upload(RenderState& rs) {
 
-    // Generate vertex buffer, if needed
-    if (m_glVertexBuffer == 0) {
-        GL::genBuffers(1, &m_glVertexBuffer);
+    if (m_hint == GL_STATIC_DRAW) {
+        uploadToArena(rs);
+        return;
     }
 
     // Buffer vertex data
     int vertexBytes = m_nVertices * m_vertexLayout->getStride();
 
+    // Get a vertex buffer, if needed
+    if (m_glVertexBuffer == 0) {
+        m_glVertexBuffer = rs.acquireBuffer(GL_ARRAY_BUFFER, vertexBytes);
+    }
+
     rs.vertexBuffer(m_glVertexBuffer);
     GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, m_glVertexData, m_hint);
 
-    delete[] m_glVertexData;
-    m_glVertexData = nullptr;
-
     if (m_glIndexData) {
 
         if (m_glIndexBuffer == 0) {
-            GL::genBuffers(1, &m_glIndexBuffer);
+            m_glIndexBuffer = rs.acquireBuffer(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * indexSize());
         }
 
         // Buffer element index data
         rs.indexBuffer(m_glIndexBuffer);
 
-        GL::bufferData(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * sizeof(GLushort), m_glIndexData, m_hint);
+        GL::bufferData(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * indexSize(), m_glIndexData, m_hint);
+    }
+
+    releaseData();
 
-        delete[] m_glIndexData;
-        m_glIndexData = nullptr;
+    m_rs = &rs;
+
+    m_isUploaded = true;
+}
+
+void MeshBase::uploadToArena(RenderState& rs) {
+
+    // Static meshes are never updated, suballocate them from larger buffers
+    // instead of creating a vertex and index buffer for each mesh
+    if (!m_vertexArena) {
+        m_vertexArena = &rs.vertexArena(m_vertexLayout->getStride());
+        m_vertexAllocation = m_vertexArena->allocate(rs, m_nVertices * m_vertexLayout->getStride(),
+                                                     m_glVertexData);
+        m_glVertexBuffer = m_vertexAllocation.buffer;
+        m_glVertexOffset = m_vertexAllocation.offset;
+    }
+
+    if (m_glIndexData && !m_indexArena) {
+        m_indexArena = &rs.indexArena();
+        m_indexAllocation = m_indexArena->allocate(rs, m_nIndices * indexSize(), m_glIndexData);
+        m_glIndexBuffer = m_indexAllocation.buffer;
+        m_glIndexOffset = m_indexAllocation.offset;
     }
 
+    releaseData();
+
     m_rs = &rs;
 
     m_isUploaded = true;
@@ -164,7 +205,8 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
     if (useVao) {
         if (!m_vaos.isInitialized()) {
             // Capture vao state
-            m_vaos.initialize(rs, _shader, m_vertexOffsets, *m_vertexLayout, m_glVertexBuffer, m_glIndexBuffer);
+            m_vaos.initialize(rs, _shader, m_vertexOffsets, *m_vertexLayout,
+                              m_glVertexBuffer, m_glIndexBuffer, m_glVertexOffset);
         }
     } else {
         // Bind buffers for drawing
@@ -185,7 +227,7 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
 
         if (!useVao) {
             // Enable vertex attribs via vertex layout object
-            size_t byteOffset = vertexOffset * m_vertexLayout->getStride();
+            size_t byteOffset = m_glVertexOffset + vertexOffset * m_vertexLayout->getStride();
             m_vertexLayout->enable(rs,  _shader, byteOffset);
         } else {
             // Bind the corresponding vao relative to the current offset
@@ -194,8 +236,8 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
 
         // Draw as elements or arrays
         if (nIndices > 0) {
-            GL::drawElements(m_drawMode, nIndices, GL_UNSIGNED_SHORT,
-                             (void*)(indiceOffset * sizeof(GLushort)));
+            GL::drawElements(m_drawMode, nIndices, m_indexType,
+                             (void*)(m_glIndexOffset + indiceOffset * indexSize()));
         } else if (nVertices > 0) {
             GL::drawArrays(m_drawMode, 0, nVertices);
         }
@@ -212,19 +254,17 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
 }
 
 size_t MeshBase::bufferSize() const {
-    return m_nVertices * m_vertexLayout->getStride() + m_nIndices * sizeof(GLushort);
+    return m_nVertices * m_vertexLayout->getStride() + m_nIndices * indexSize();
 }
 
 // Add indices by collecting them into batches to draw as much as
 // possible in one draw call.  The indices must be shifted by the
 // number of vertices that are present in the current batch.
-size_t MeshBase::compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
-                                const std::vector<uint16_t>& _indices, size_t _offset) {
-
+void MeshBase::compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
+                              GLushort* _indices) {
 
-    GLushort* dst = m_glIndexData + _offset;
+    GLushort* dst = _indices;
     size_t curVertices = 0;
-    size_t src = 0;
 
     if (m_vertexOffsets.empty()) {
         m_vertexOffsets.emplace_back(0, 0);
@@ -241,7 +281,7 @@ size_t MeshBase::compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>
             curVertices = 0;
         }
         for (size_t i = 0; i < nIndices; i++, dst++) {
-            *dst = _indices[src++] + curVertices;
+            *dst += curVertices;
         }
 
         auto& offset = m_vertexOffsets.back();
@@ -250,8 +290,6 @@ size_t MeshBase::compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>
 
         curVertices += nVertices;
     }
-
-    return _offset + src;
 }
 
 void MeshBase::setDirty(GLintptr _byteOffset, GLsizei _byteSize) {
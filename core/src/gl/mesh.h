@@ -3,6 +3,8 @@
 #include "gl.h"
 #include "gl/vertexLayout.h"
 #include "gl/vao.h"
+#include "gl/bufferArena.h"
+#include "gl/hardware.h"
 #include "style/style.h"
 #include "util/types.h"
 #include "platform.h"
@@ -10,8 +12,11 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <cstring> // for memcpy
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 #define MAX_INDEX_VALUE 65535 // Maximum value of GLushort
 
@@ -83,16 +88,21 @@ protected:
 
     size_t m_nVertices;
     GLuint m_glVertexBuffer;
+    // Offset of the vertices in m_glVertexBuffer, when suballocated from a BufferArena
+    GLintptr m_glVertexOffset = 0;
 
     Vao m_vaos;
 
-    // Compiled vertices for upload
+    // Compiled vertices for upload, the storage is owned by the derived mesh
     GLbyte* m_glVertexData = nullptr;
 
     size_t m_nIndices;
     GLuint m_glIndexBuffer;
-    // Compiled  indices for upload
-    GLushort* m_glIndexData = nullptr;
+    GLintptr m_glIndexOffset = 0;
+    // Compiled  indices for upload, the storage is owned by the derived mesh
+    GLbyte* m_glIndexData = nullptr;
+    // GL_UNSIGNED_INT when the mesh is drawn with 32 bit indices
+    GLenum m_indexType = GL_UNSIGNED_SHORT;
 
     GLenum m_drawMode;
     GLenum m_hint;
@@ -103,15 +113,88 @@ protected:
 
     RenderState* m_rs = nullptr;
 
+    // Static meshes are uploaded to the buffer arenas of the RenderState
+    BufferArena* m_vertexArena = nullptr;
+    BufferArena* m_indexArena = nullptr;
+    BufferArena::Allocation m_vertexAllocation;
+    BufferArena::Allocation m_indexAllocation;
+
     GLsizei m_dirtySize;
     GLintptr m_dirtyOffset;
 
-    size_t compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
-                          const std::vector<uint16_t>& _indices, size_t _offset);
+    // Shifts the indices of each vertex range in @_offsets by the number of vertices
+    // before it in the current batch; the indices are updated in place
+    void compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
+                        GLushort* _indices);
+
+    size_t indexSize() const {
+        return m_indexType == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+    }
+
+    void uploadToArena(RenderState& rs);
+
+    // Frees the GPU buffers and VAOs of the mesh
+    void releaseBuffers();
+
+    // Frees the compiled vertex and index data after upload
+    virtual void releaseData() {}
 
     void setDirty(GLintptr _byteOffset, GLsizei _byteSize);
 };
 
+/*
+ * MeshBufferPool - Keeps the vertex and index buffers of uploaded meshes, so that
+ * style builders can reuse their capacity when building the next tiles
+ */
+template<class T>
+class MeshBufferPool {
+public:
+    // Replaces @_buffer with a pooled buffer when it has no capacity
+    static void acquire(std::vector<T>& _buffer) {
+        if (_buffer.capacity() > 0) { return; }
+
+        std::lock_guard<std::mutex> lock(mutex());
+        auto& buffers = pool();
+        if (!buffers.empty()) {
+            _buffer.swap(buffers.back());
+            buffers.pop_back();
+        }
+    }
+
+    static void release(std::vector<T>& _buffer) {
+        if (_buffer.capacity() == 0) { return; }
+
+        std::vector<T> buffer;
+        buffer.swap(_buffer);
+        buffer.clear();
+
+        std::lock_guard<std::mutex> lock(mutex());
+        auto& buffers = pool();
+        if (buffers.size() < maxBuffers) {
+            buffers.push_back(std::move(buffer));
+        }
+    }
+
+    static size_t size() {
+        std::lock_guard<std::mutex> lock(mutex());
+        return pool().size();
+    }
+
+private:
+    // Enough for the builders of the tile workers
+    static constexpr size_t maxBuffers = 8;
+
+    static std::vector<std::vector<T>>& pool() {
+        static std::vector<std::vector<T>> buffers;
+        return buffers;
+    }
+
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+};
+
 template<class T>
 struct MeshData {
 
@@ -126,10 +209,13 @@ struct MeshData {
     std::vector<T> vertices;
     std::vector<std::pair<uint32_t, uint32_t>> offsets;
 
+    // Buffers that were passed to a Mesh are replaced by pooled ones
     void clear() {
         offsets.clear();
         indices.clear();
         vertices.clear();
+        MeshBufferPool<uint16_t>::acquire(indices);
+        MeshBufferPool<T>::acquire(vertices);
     }
 };
 
@@ -141,7 +227,7 @@ public:
          GLenum _hint = GL_STATIC_DRAW)
         : MeshBase(_vertexLayout, _drawMode, _hint) {};
 
-    virtual ~Mesh() {}
+    virtual ~Mesh() { freeData(); }
 
     size_t bufferSize() const override {
         return MeshBase::bufferSize();
@@ -151,8 +237,43 @@ public:
         return MeshBase::draw(rs, shader, useVao);
     }
 
+    bool isResident() const override {
+        return m_isUploaded || !m_isCompiled || m_nVertices == 0;
+    }
+
+    size_t makeResident(RenderState& rs) override {
+        if (isResident()) { return 0; }
+        upload(rs);
+        return MeshBase::bufferSize();
+    }
+
+    void releaseResident() override {
+        // Only meshes with retained data can be uploaded again
+        if (m_positionScale != 0.f && m_isUploaded) { releaseBuffers(); }
+    }
+
+    /*
+     * Keep the compiled data after upload so that the mesh can be merged with the
+     * meshes of neighboring tiles. @_positionScale is the number of 'a_position'
+     * units per tile, positions must be stored as GL_SHORT.
+     */
+    void retainData(float _positionScale) { m_positionScale = _positionScale; }
+
+    std::unique_ptr<StyledMesh> merge(const std::vector<MergeItem>& _meshes) const override;
+
+    /*
+     * Compile vertices and indices of _meshes for upload. The rvalue versions take
+     * the buffers of the first mesh instead of copying them, so that the geometry
+     * built by a style builder is not duplicated until upload.
+     * Meshes exceeding the range of 16 bit indices are drawn in one batch with
+     * 32 bit indices when supported, otherwise they are split into batches.
+     */
+    void compile(std::vector<MeshData<T>>&& _meshes);
+
     void compile(const std::vector<MeshData<T>>& _meshes);
 
+    void compile(MeshData<T>&& _mesh);
+
     void compile(const MeshData<T>& _mesh);
 
     /*
@@ -169,11 +290,101 @@ public:
     template<class A>
     void updateAttribute(Range _vertexRange, const A& _newAttributeValue,
                          size_t _attribOffset = 0);
+
+protected:
+
+    void releaseData() override {
+        if (m_positionScale == 0.f) { freeData(); }
+    }
+
+private:
+
+    void freeData() {
+        MeshBufferPool<T>::release(m_vertices);
+        MeshBufferPool<uint16_t>::release(m_indices);
+        MeshBufferPool<uint32_t>::release(m_indices32);
+        m_glVertexData = nullptr;
+        m_glIndexData = nullptr;
+    }
+
+    void compileData(std::vector<MeshData<T>>& _meshes);
+
+    std::vector<T> m_vertices;
+    std::vector<uint16_t> m_indices;
+    std::vector<uint32_t> m_indices32;
+
+    // Set by retainData()
+    float m_positionScale = 0.f;
 };
 
+template<class T>
+std::unique_ptr<StyledMesh> Mesh<T>::merge(const std::vector<MergeItem>& _meshes) const {
+
+    if (m_positionScale == 0.f) { return nullptr; }
+
+    auto attribs = m_vertexLayout->getAttribs();
+    auto position = std::find_if(attribs.begin(), attribs.end(),
+                                 [](const auto& a) { return a.name == "a_position"; });
+
+    if (position == attribs.end() || position->type != GL_SHORT || position->size < 2) {
+        return nullptr;
+    }
+
+    std::vector<MeshData<T>> meshes;
+
+    for (auto& item : _meshes) {
+        auto* mesh = dynamic_cast<const Mesh<T>*>(item.mesh);
+
+        // Only meshes that kept their data and are drawn with 16 bit indices
+        if (!mesh || mesh->m_positionScale != m_positionScale ||
+            mesh->m_drawMode != m_drawMode || mesh->m_vertexLayout != m_vertexLayout ||
+            mesh->m_nIndices == 0 || mesh->m_indexType != GL_UNSIGNED_SHORT ||
+            mesh->m_vertices.size() != mesh->m_nVertices ||
+            mesh->m_indices.size() != mesh->m_nIndices) {
+            return nullptr;
+        }
+
+        glm::ivec2 shift = glm::ivec2(glm::vec2(item.offset) * m_positionScale);
+
+        size_t vertexOffset = 0;
+        size_t indexOffset = 0;
+
+        // Indices of the compiled batches are relative to their first vertex
+        for (auto& batch : mesh->m_vertexOffsets) {
+            meshes.emplace_back();
+            auto& data = meshes.back();
+
+            auto vertices = mesh->m_vertices.begin() + vertexOffset;
+            data.vertices.assign(vertices, vertices + batch.second);
+
+            auto indices = mesh->m_indices.begin() + indexOffset;
+            data.indices.assign(indices, indices + batch.first);
+
+            data.offsets.emplace_back(batch.first, batch.second);
+
+            for (auto& vertex : data.vertices) {
+                auto* pos = reinterpret_cast<int16_t*>(reinterpret_cast<GLbyte*>(&vertex) +
+                                                       position->offset);
+                for (int i = 0; i < 2; i++) {
+                    int32_t p = pos[i] + shift[i];
+                    if (p < INT16_MIN || p > INT16_MAX) { return nullptr; }
+                    pos[i] = p;
+                }
+            }
+            vertexOffset += batch.second;
+            indexOffset += batch.first;
+        }
+    }
+
+    auto mesh = std::make_unique<Mesh<T>>(m_vertexLayout, m_drawMode, m_hint);
+    mesh->compile(std::move(meshes));
+
+    return std::move(mesh);
+}
+
 
 template<class T>
-void Mesh<T>::compile(const std::vector<MeshData<T>>& _meshes) {
+void Mesh<T>::compileData(std::vector<MeshData<T>>& _meshes) {
 
     m_nVertices = 0;
     m_nIndices = 0;
@@ -183,53 +394,85 @@ void Mesh<T>::compile(const std::vector<MeshData<T>>& _meshes) {
         m_nIndices += m.indices.size();
     }
 
-    int stride = m_vertexLayout->getStride();
-    m_glVertexData = new GLbyte[m_nVertices * stride];
-
-    size_t offset = 0;
+    // Take the vertex buffer of the first mesh and append the others
     for (auto& m : _meshes) {
-        size_t nBytes = m.vertices.size() * stride;
-        std::memcpy(m_glVertexData + offset,
-                    (const GLbyte*)m.vertices.data(),
-                    nBytes);
-
-        offset += nBytes;
+        if (m_vertices.empty()) {
+            m_vertices.swap(m.vertices);
+        } else {
+            m_vertices.insert(m_vertices.end(), m.vertices.begin(), m.vertices.end());
+        }
     }
+    assert(m_vertices.size() == m_nVertices);
+    m_glVertexData = reinterpret_cast<GLbyte*>(m_vertices.data());
 
-    assert(offset == m_nVertices * stride);
+    if (m_nVertices > MAX_INDEX_VALUE && m_nIndices > 0 && Hardware::supportsElementIndexUint) {
+        // Draw all vertices in one batch with 32 bit indices
+        MeshBufferPool<uint32_t>::acquire(m_indices32);
+        m_indices32.reserve(m_nIndices);
 
-    if (m_nIndices > 0) {
-        m_glIndexData = new GLushort[m_nIndices];
+        uint32_t curVertices = 0;
+        for (auto& m : _meshes) {
+            size_t src = 0;
+            for (auto& o : m.offsets) {
+                for (size_t i = 0; i < o.first; i++) {
+                    m_indices32.push_back(m.indices[src++] + curVertices);
+                }
+                curVertices += o.second;
+            }
+        }
+        assert(m_indices32.size() == m_nIndices);
+
+        m_vertexOffsets.emplace_back(m_nIndices, m_nVertices);
+        m_indexType = GL_UNSIGNED_INT;
+        m_glIndexData = reinterpret_cast<GLbyte*>(m_indices32.data());
 
-        size_t offset = 0;
+    } else {
+        // Take the index buffer of the first mesh and split the indices
+        // into batches that can be drawn with 16 bit indices
         for (auto& m : _meshes) {
-            offset = compileIndices(m.offsets, m.indices, offset);
+            size_t offset = m_indices.size();
+            if (m_indices.empty()) {
+                m_indices.swap(m.indices);
+            } else {
+                m_indices.insert(m_indices.end(), m.indices.begin(), m.indices.end());
+            }
+            compileIndices(m.offsets, m_indices.data() + offset);
         }
-        assert(offset == m_nIndices);
+        assert(m_indices.size() == m_nIndices);
+
+        m_indexType = GL_UNSIGNED_SHORT;
+        m_glIndexData = m_nIndices > 0 ? reinterpret_cast<GLbyte*>(m_indices.data()) : nullptr;
     }
 
     m_isCompiled = true;
 }
 
 template<class T>
-void Mesh<T>::compile(const MeshData<T>& _mesh) {
-
-    m_nVertices = _mesh.vertices.size();
-    m_nIndices = _mesh.indices.size();
-
-    int stride = m_vertexLayout->getStride();
-    m_glVertexData = new GLbyte[m_nVertices * stride];
+void Mesh<T>::compile(std::vector<MeshData<T>>&& _meshes) {
+    compileData(_meshes);
+}
 
-    std::memcpy(m_glVertexData,
-                (const GLbyte*)_mesh.vertices.data(),
-                m_nVertices * stride);
+template<class T>
+void Mesh<T>::compile(const std::vector<MeshData<T>>& _meshes) {
+    std::vector<MeshData<T>> meshes(_meshes);
+    compileData(meshes);
+}
 
-    if (m_nIndices > 0) {
-        m_glIndexData = new GLushort[m_nIndices];
-        compileIndices(_mesh.offsets, _mesh.indices, 0);
-    }
+template<class T>
+void Mesh<T>::compile(MeshData<T>&& _mesh) {
+    std::vector<MeshData<T>> meshes(1);
+    meshes[0].vertices.swap(_mesh.vertices);
+    meshes[0].indices.swap(_mesh.indices);
+    meshes[0].offsets.swap(_mesh.offsets);
+    compileData(meshes);
+    // Keep the offsets of _mesh for reuse
+    _mesh.offsets.swap(meshes[0].offsets);
+}
 
-    m_isCompiled = true;
+template<class T>
+void Mesh<T>::compile(const MeshData<T>& _mesh) {
+    std::vector<MeshData<T>> meshes{ _mesh };
+    compileData(meshes);
 }
 
 template<class T>
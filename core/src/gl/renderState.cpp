@@ -7,6 +7,8 @@
 #include "log.h"
 #include "platform.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
 
 namespace Tangram {
@@ -37,30 +39,45 @@ RenderState::RenderState() {
 
 }
 
-void RenderState::flushResourceDeletion() {
-    std::lock_guard<std::mutex> guard(m_deletionListMutex);
-
-    if (m_VAODeletionList.size()) {
-        GL::deleteVertexArrays(m_VAODeletionList.size(), m_VAODeletionList.data());
-        m_VAODeletionList.clear();
+void RenderState::flushResourceDeletion(float _maxTime) {
+    for (auto& arena : m_vertexArenas) {
+        arena.second->flush();
     }
-    if (m_textureDeletionList.size()) {
-        GL::deleteTextures(m_textureDeletionList.size(), m_textureDeletionList.data());
-        m_textureDeletionList.clear();
-    }
-    if (m_bufferDeletionList.size()) {
-        GL::deleteBuffers(m_bufferDeletionList.size(), m_bufferDeletionList.data());
-        m_bufferDeletionList.clear();
-    }
-    if (m_framebufferDeletionList.size()) {
-        GL::deleteFramebuffers(m_framebufferDeletionList.size(), m_framebufferDeletionList.data());
-        m_framebufferDeletionList.clear();
-    }
-    if (m_programDeletionList.size()) {
-        for (GLuint program : m_programDeletionList) {
-            GL::deleteProgram(program);
+    m_indexArena.flush();
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Delete at most this number of handles of each kind between time checks
+    const size_t chunkSize = 32;
+
+    auto deleteChunk = [&](std::vector<GLuint>& _list, auto _delete) {
+        size_t count = std::min(_list.size(), chunkSize);
+        if (count > 0) {
+            _delete(count, _list.data() + _list.size() - count);
+            _list.resize(_list.size() - count);
         }
-        m_programDeletionList.clear();
+        return _list.empty();
+    };
+
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+    // Large batches of deletions, e.g. when a zoom level is evicted from
+    // the tile cache, are spread over several frames
+    while (true) {
+        bool done = true;
+
+        done &= deleteChunk(m_VAODeletionList, [](GLsizei n, GLuint* h) { GL::deleteVertexArrays(n, h); });
+        done &= deleteChunk(m_textureDeletionList, [](GLsizei n, GLuint* h) { GL::deleteTextures(n, h); });
+        done &= deleteChunk(m_bufferDeletionList, [](GLsizei n, GLuint* h) { GL::deleteBuffers(n, h); });
+        done &= deleteChunk(m_framebufferDeletionList, [](GLsizei n, GLuint* h) { GL::deleteFramebuffers(n, h); });
+        done &= deleteChunk(m_programDeletionList, [](GLsizei n, GLuint* h) {
+            for (GLsizei i = 0; i < n; i++) { GL::deleteProgram(h[i]); }
+        });
+
+        if (done) { break; }
+
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+        if (elapsed.count() >= _maxTime) { break; }
     }
 }
 
@@ -89,6 +106,134 @@ void RenderState::queueBufferDeletion(size_t count, GLuint* buffers) {
     m_bufferDeletionList.insert(m_bufferDeletionList.end(), buffers, buffers + count);
 }
 
+GLuint RenderState::acquire(ResourcePool& _pool, uint64_t _key) {
+    auto& resources = _pool.resources;
+
+    // Prefer the most recently released resource
+    for (auto it = resources.rbegin(); it != resources.rend(); ++it) {
+        if (it->key == _key) {
+            GLuint handle = it->handle;
+            _pool.bytes -= it->bytes;
+            resources.erase(std::next(it).base());
+            return handle;
+        }
+    }
+    return 0;
+}
+
+void RenderState::release(ResourcePool& _pool, size_t _maxCount, size_t _maxBytes,
+                          PooledResource _resource, std::vector<GLuint>& _deletionList) {
+    auto& resources = _pool.resources;
+
+    // Make room by deleting the oldest resources
+    size_t evict = 0;
+    while (evict < resources.size() &&
+           (resources.size() - evict >= _maxCount || _pool.bytes + _resource.bytes > _maxBytes)) {
+        _deletionList.push_back(resources[evict].handle);
+        _pool.bytes -= resources[evict].bytes;
+        evict++;
+    }
+    resources.erase(resources.begin(), resources.begin() + evict);
+
+    resources.push_back(_resource);
+    _pool.bytes += _resource.bytes;
+}
+
+void RenderState::clear(ResourcePool& _pool, std::vector<GLuint>& _deletionList) {
+    for (auto& resource : _pool.resources) {
+        _deletionList.push_back(resource.handle);
+    }
+    _pool.resources.clear();
+    _pool.bytes = 0;
+}
+
+static uint64_t textureKey(GLsizei _width, GLsizei _height, GLenum _format) {
+    return (uint64_t(_width & 0xffff) << 48) | (uint64_t(_height & 0xffff) << 32) | _format;
+}
+
+// Buffers are pooled by the power of two size class of their last data
+static uint64_t bufferKey(GLenum _target, GLsizeiptr _size) {
+    uint64_t sizeClass = 0;
+    while ((GLsizeiptr(1) << sizeClass) < _size) { sizeClass++; }
+    return (uint64_t(_target) << 32) | sizeClass;
+}
+
+GLuint RenderState::acquireTexture(GLsizei _width, GLsizei _height, GLenum _format) {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+    GLuint texture = acquire(m_texturePool, textureKey(_width, _height, _format));
+
+    if (texture) {
+        m_poolStats.textureHits++;
+    } else {
+        m_poolStats.textureMisses++;
+    }
+    return texture;
+}
+
+void RenderState::releaseTexture(GLuint _texture, GLsizei _width, GLsizei _height, GLenum _format,
+                                 size_t _bytes) {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+    if (_bytes > MAX_POOLED_TEXTURE_SIZE) {
+        m_textureDeletionList.push_back(_texture);
+        return;
+    }
+
+    release(m_texturePool, MAX_POOLED_TEXTURES, MAX_POOLED_TEXTURE_BYTES,
+            { _texture, textureKey(_width, _height, _format), _bytes }, m_textureDeletionList);
+}
+
+GLuint RenderState::acquireBuffer(GLenum _target, GLsizeiptr _size) {
+    GLuint buffer = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+        buffer = acquire(m_bufferPool, bufferKey(_target, _size));
+
+        if (buffer) {
+            m_poolStats.bufferHits++;
+        } else {
+            m_poolStats.bufferMisses++;
+        }
+    }
+
+    if (!buffer) {
+        GL::genBuffers(1, &buffer);
+    }
+    return buffer;
+}
+
+void RenderState::releaseBuffer(GLuint _buffer, GLenum _target, GLsizeiptr _size) {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+    if (_size > MAX_POOLED_BUFFER_SIZE) {
+        m_bufferDeletionList.push_back(_buffer);
+        return;
+    }
+
+    release(m_bufferPool, MAX_POOLED_BUFFERS, MAX_POOLED_BUFFER_BYTES,
+            { _buffer, bufferKey(_target, _size), size_t(_size) }, m_bufferDeletionList);
+}
+
+void RenderState::clearResourcePools() {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+
+    clear(m_texturePool, m_textureDeletionList);
+    clear(m_bufferPool, m_bufferDeletionList);
+}
+
+RenderState::PoolStats RenderState::poolStats() {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+    return m_poolStats;
+}
+
+size_t RenderState::pendingDeletions() {
+    std::lock_guard<std::mutex> guard(m_deletionListMutex);
+    return m_VAODeletionList.size() + m_textureDeletionList.size() + m_bufferDeletionList.size() +
+        m_framebufferDeletionList.size() + m_programDeletionList.size();
+}
+
 GLuint RenderState::getTextureUnit(GLuint _unit) {
     return GL_TEXTURE0 + _unit;
 }
@@ -96,8 +241,15 @@ GLuint RenderState::getTextureUnit(GLuint _unit) {
 RenderState::~RenderState() {
 
     deleteQuadIndexBuffer();
+
+    clearResourcePools();
     flushResourceDeletion();
 
+    for (auto& arena : m_vertexArenas) {
+        arena.second->dispose();
+    }
+    m_indexArena.dispose();
+
     for (auto& s : vertexShaders) {
         GL::deleteShader(s.second);
     }
@@ -157,7 +309,14 @@ void RenderState::invalidateHandles() {
         m_framebufferDeletionList.clear();
         m_programDeletionList.clear();
         m_shaderDeletionList.clear();
+        m_texturePool = {};
+        m_bufferPool = {};
     }
+
+    for (auto& arena : m_vertexArenas) {
+        arena.second->invalidate();
+    }
+    m_indexArena.invalidate();
 }
 
 void RenderState::cacheDefaultFramebuffer() {
@@ -197,8 +356,10 @@ bool RenderState::blending(GLboolean enable) {
     if (!m_blending.set || m_blending.enabled != enable) {
         m_blending = { enable, true };
         setGlFlag(GL_BLEND, enable);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -206,8 +367,10 @@ bool RenderState::blendingFunc(GLenum sfactor, GLenum dfactor) {
     if (!m_blendingFunc.set || m_blendingFunc.sfactor != sfactor || m_blendingFunc.dfactor != dfactor) {
         m_blendingFunc = { sfactor, dfactor, true };
         GL::blendFunc(sfactor, dfactor);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -229,8 +392,10 @@ bool RenderState::clearColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a) {
     if (!m_clearColor.set || m_clearColor.r != r || m_clearColor.g != g || m_clearColor.b != b || m_clearColor.a != a) {
         m_clearColor = { r, g, b, a, true };
         GL::clearColor(r, g, b, a);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -238,8 +403,10 @@ bool RenderState::colorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a)
     if (!m_colorMask.set || m_colorMask.r != r || m_colorMask.g != g || m_colorMask.b != b || m_colorMask.a != a) {
         m_colorMask = { r, g, b, a, true };
         GL::colorMask(r, g, b, a);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -247,8 +414,10 @@ bool RenderState::cullFace(GLenum face) {
     if (!m_cullFace.set || m_cullFace.face != face) {
         m_cullFace = { face, true };
         GL::cullFace(face);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -256,8 +425,10 @@ bool RenderState::culling(GLboolean enable) {
     if (!m_culling.set || m_culling.enabled != enable) {
         m_culling = { enable, true };
         setGlFlag(GL_CULL_FACE, enable);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -265,8 +436,10 @@ bool RenderState::depthTest(GLboolean enable) {
     if (!m_depthTest.set || m_depthTest.enabled != enable) {
         m_depthTest = { enable, true };
         setGlFlag(GL_DEPTH_TEST, enable);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -274,8 +447,10 @@ bool RenderState::depthMask(GLboolean enable) {
     if (!m_depthMask.set || m_depthMask.enabled != enable) {
         m_depthMask = { enable, true };
         GL::depthMask(enable);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -283,8 +458,10 @@ bool RenderState::frontFace(GLenum face) {
     if (!m_frontFace.set || m_frontFace.face != face) {
         m_frontFace = { face, true };
         GL::frontFace(face);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -292,8 +469,10 @@ bool RenderState::stencilMask(GLuint mask) {
     if (!m_stencilMask.set || m_stencilMask.mask != mask) {
         m_stencilMask = { mask, true };
         GL::stencilMask(mask);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -301,8 +480,10 @@ bool RenderState::stencilFunc(GLenum func, GLint ref, GLuint mask) {
     if (!m_stencilFunc.set || m_stencilFunc.func != func || m_stencilFunc.ref != ref || m_stencilFunc.mask != mask) {
         m_stencilFunc = { func, ref, mask, true };
         GL::stencilFunc(func, ref, mask);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -310,8 +491,10 @@ bool RenderState::stencilOp(GLenum sfail, GLenum spassdfail, GLenum spassdpass)
     if (!m_stencilOp.set || m_stencilOp.sfail != sfail || m_stencilOp.spassdfail != spassdfail || m_stencilOp.spassdpass != spassdpass) {
         m_stencilOp = { sfail, spassdfail, spassdpass, true };
         GL::stencilOp(sfail, spassdfail, spassdpass);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -319,8 +502,10 @@ bool RenderState::stencilTest(GLboolean enable) {
     if (!m_stencilTest.set || m_stencilTest.enabled != enable) {
         m_stencilTest = { enable, true };
         setGlFlag(GL_STENCIL_TEST, enable);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -328,8 +513,10 @@ bool RenderState::shaderProgram(GLuint program) {
     if (!m_program.set || m_program.program != program) {
         m_program = { program, true };
         GL::useProgram(program);
+        m_frameStats.programBinds++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -343,6 +530,9 @@ void RenderState::texture(GLuint handle, GLuint unit, GLenum target) {
     if (!m_texture.set || m_texture.target != target || m_texture.handle != handle) {
         m_texture = { target, handle, true };
         GL::bindTexture(target, handle);
+        m_frameStats.textureBinds++;
+    } else {
+        m_frameStats.redundantStates++;
     }
 }
 
@@ -350,8 +540,10 @@ bool RenderState::vertexBuffer(GLuint handle) {
     if (!m_vertexBuffer.set || m_vertexBuffer.handle != handle) {
         m_vertexBuffer = { handle, true };
         GL::bindBuffer(GL_ARRAY_BUFFER, handle);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -359,8 +551,10 @@ bool RenderState::indexBuffer(GLuint handle) {
     if (!m_indexBuffer.set || m_indexBuffer.handle != handle) {
         m_indexBuffer = { handle, true };
         GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, handle);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -370,6 +564,18 @@ void RenderState::indexBufferUnset(GLuint handle) {
     }
 }
 
+BufferArena& RenderState::vertexArena(size_t _stride) {
+    auto& arena = m_vertexArenas[_stride];
+    if (!arena) {
+        arena = std::make_unique<BufferArena>(GL_ARRAY_BUFFER, VERTEX_ARENA_PAGE_SIZE);
+    }
+    return *arena;
+}
+
+BufferArena& RenderState::indexArena() {
+    return m_indexArena;
+}
+
 GLuint RenderState::getQuadIndexBuffer() {
     if (m_quadIndexBuffer == 0) {
         generateQuadIndexBuffer();
@@ -408,8 +614,10 @@ bool RenderState::framebuffer(GLuint handle) {
     if (!m_framebuffer.set || m_framebuffer.handle != handle) {
         m_framebuffer = { handle, true };
         GL::bindFramebuffer(GL_FRAMEBUFFER, handle);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -418,8 +626,10 @@ bool RenderState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
       || m_viewport.width != width || m_viewport.height != height) {
         m_viewport = { x, y, width, height, true };
         GL::viewport(x, y, width, height);
+        m_frameStats.stateChanges++;
         return false;
     }
+    m_frameStats.redundantStates++;
     return true;
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "gl.h"
+#include "gl/bufferArena.h"
 #include <array>
+#include <limits>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <vector>
@@ -21,6 +24,25 @@ public:
 
     static constexpr size_t MAX_QUAD_VERTICES = 16384;
 
+    static constexpr size_t VERTEX_ARENA_PAGE_SIZE = 1 << 21;
+
+    static constexpr size_t INDEX_ARENA_PAGE_SIZE = 1 << 19;
+
+    // Time budget in milliseconds for deleting queued GL resources in one frame
+    static constexpr float RESOURCE_DELETION_TIME = 1.f;
+
+    // Limits of the pools of released resources, the oldest resources
+    // are deleted to stay within the number of resources and bytes
+    static constexpr size_t MAX_POOLED_TEXTURES = 32;
+    static constexpr size_t MAX_POOLED_TEXTURE_BYTES = 1 << 24;
+
+    static constexpr size_t MAX_POOLED_BUFFERS = 64;
+    static constexpr size_t MAX_POOLED_BUFFER_BYTES = 1 << 24;
+
+    // Larger textures and buffers are deleted instead of pooled
+    static constexpr size_t MAX_POOLED_TEXTURE_SIZE = 1 << 22;
+    static constexpr GLsizeiptr MAX_POOLED_BUFFER_SIZE = 1 << 20;
+
     RenderState();
     ~RenderState();
 
@@ -107,7 +129,9 @@ public:
 
     GLuint getQuadIndexBuffer();
 
-    void flushResourceDeletion();
+    // Delete the queued resources. Resources that cannot be deleted within
+    // @_maxTime milliseconds are left for the next call.
+    void flushResourceDeletion(float _maxTime = std::numeric_limits<float>::max());
 
     void queueTextureDeletion(GLuint texture);
 
@@ -119,6 +143,58 @@ public:
 
     void queueProgramDeletion(GLuint program);
 
+    // Returns a texture of the pool that has storage for @_width x @_height pixels
+    // of @_format, or 0 when there is none
+    GLuint acquireTexture(GLsizei _width, GLsizei _height, GLenum _format);
+
+    // Keep @_texture with @_bytes of storage for reuse by acquireTexture(). The oldest
+    // textures of the pool are queued for deletion when it is full. May be called from
+    // any thread.
+    void releaseTexture(GLuint _texture, GLsizei _width, GLsizei _height, GLenum _format,
+                        size_t _bytes);
+
+    // Returns a buffer of the pool that last held about @_size bytes, or a new buffer
+    GLuint acquireBuffer(GLenum _target, GLsizeiptr _size);
+
+    // Keep @_buffer with @_size bytes for reuse by acquireBuffer(). May be called from any thread.
+    void releaseBuffer(GLuint _buffer, GLenum _target, GLsizeiptr _size);
+
+    // Queue all pooled resources for deletion, e.g. on memory warnings
+    void clearResourcePools();
+
+    struct PoolStats {
+        uint32_t textureHits = 0;
+        uint32_t textureMisses = 0;
+        uint32_t bufferHits = 0;
+        uint32_t bufferMisses = 0;
+    };
+
+    // Number of acquired resources that were reused
+    PoolStats poolStats();
+
+    // Number of resources waiting for deletion
+    size_t pendingDeletions();
+
+    // Arena for the vertex data of static meshes with vertices of @_stride bytes
+    BufferArena& vertexArena(size_t _stride);
+
+    // Arena for the indices of static meshes
+    BufferArena& indexArena();
+
+    // Number of GL state changes since the last resetFrameStats()
+    struct FrameStats {
+        uint32_t programBinds = 0;
+        uint32_t textureBinds = 0;
+        // Other states that were passed to GL
+        uint32_t stateChanges = 0;
+        // State changes that were skipped because the state was already set
+        uint32_t redundantStates = 0;
+    };
+
+    const FrameStats& frameStats() const { return m_frameStats; }
+
+    void resetFrameStats() { m_frameStats = {}; }
+
     std::array<GLuint, MAX_ATTRIBUTES> attributeBindings = { { 0 } };
 
     std::unordered_map<std::string, GLuint> fragmentShaders;
@@ -135,6 +211,8 @@ private:
 
     float m_frameTime = 0.f;
 
+    FrameStats m_frameStats;
+
     std::mutex m_deletionListMutex;
     std::vector<GLuint> m_VAODeletionList;
     std::vector<GLuint> m_bufferDeletionList;
@@ -143,8 +221,35 @@ private:
     std::vector<GLuint> m_shaderDeletionList;
     std::vector<GLuint> m_framebufferDeletionList;
 
+    struct PooledResource {
+        GLuint handle;
+        // Size and format of a texture, target and size class of a buffer
+        uint64_t key;
+        size_t bytes;
+    };
+
+    struct ResourcePool {
+        std::vector<PooledResource> resources;
+        size_t bytes = 0;
+    };
+
+    static GLuint acquire(ResourcePool& _pool, uint64_t _key);
+
+    static void release(ResourcePool& _pool, size_t _maxCount, size_t _maxBytes,
+                        PooledResource _resource, std::vector<GLuint>& _deletionList);
+
+    static void clear(ResourcePool& _pool, std::vector<GLuint>& _deletionList);
+
+    // Guarded by m_deletionListMutex
+    ResourcePool m_texturePool;
+    ResourcePool m_bufferPool;
+    PoolStats m_poolStats;
+
     uint32_t m_nextTextureUnit = 0;
 
+    std::unordered_map<size_t, std::unique_ptr<BufferArena>> m_vertexArenas;
+    BufferArena m_indexArena{ GL_ELEMENT_ARRAY_BUFFER, INDEX_ARENA_PAGE_SIZE };
+
     GLuint m_quadIndexBuffer = 0;
     void deleteQuadIndexBuffer();
     void generateQuadIndexBuffer();
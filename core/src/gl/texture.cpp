@@ -23,8 +23,15 @@ Texture::Texture(const uint8_t* data, size_t length, TextureOptions options)
 }
 
 Texture::~Texture() {
-    if (m_rs) {
-        m_rs->queueTextureDeletion(m_glHandle);
+    if (m_rs && m_glHandle) {
+        if (m_shouldResize) {
+            m_rs->queueTextureDeletion(m_glHandle);
+        } else {
+            // Keep the texture storage for a texture of the same size
+            m_rs->releaseTexture(m_glHandle, m_width, m_height,
+                                 static_cast<GLenum>(m_options.pixelFormat),
+                                 m_width * m_height * bpp());
+        }
     }
 }
 
@@ -100,7 +107,9 @@ void Texture::setSpriteAtlas(std::unique_ptr<Tangram::SpriteAtlas> sprites) {
 }
 
 void Texture::generate(RenderState& _rs, GLuint _textureUnit) {
-    GL::genTextures(1, &m_glHandle);
+    if (m_glHandle == 0) {
+        GL::genTextures(1, &m_glHandle);
+    }
 
     _rs.texture(m_glHandle, _textureUnit, GL_TEXTURE_2D);
 
@@ -126,15 +135,25 @@ bool Texture::upload(RenderState& _rs, GLuint _textureUnit) {
         if (m_disposeBuffer) { m_buffer.reset(); }
         return false;
     }
+    auto format = static_cast<GLenum>(m_options.pixelFormat);
+    bool hasStorage = false;
+
     if (m_glHandle == 0) {
+        // Reuse a released texture of the same size
+        m_glHandle = _rs.acquireTexture(m_width, m_height, format);
+        hasStorage = (m_glHandle != 0);
         generate(_rs, _textureUnit);
     } else {
         _rs.texture(m_glHandle, _textureUnit, GL_TEXTURE_2D);
     }
 
-    auto format = static_cast<GLenum>(m_options.pixelFormat);
-    GL::texImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format,
-                   GL_UNSIGNED_BYTE, m_buffer.get());
+    if (!hasStorage) {
+        GL::texImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format,
+                       GL_UNSIGNED_BYTE, m_buffer.get());
+    } else if (m_buffer) {
+        GL::texSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, format,
+                          GL_UNSIGNED_BYTE, m_buffer.get());
+    }
 
     if (m_buffer && m_options.generateMipmaps) {
         GL::generateMipmap(GL_TEXTURE_2D);
@@ -179,6 +198,53 @@ void Texture::resize(int width, int height) {
     m_shouldResize = true;
 }
 
+bool Texture::downsample(int _minSize) {
+    if (!m_buffer || _minSize <= 0) { return false; }
+
+    const int bpp = static_cast<int>(this->bpp());
+    int width = m_width;
+    int height = m_height;
+
+    if (width / 2 < _minSize || height / 2 < _minSize) { return false; }
+
+    // Average 2x2 blocks in place: Each destination pixel is written at
+    // or before the first source pixel that is read for it.
+    GLubyte* data = m_buffer.get();
+    while (width / 2 >= _minSize && height / 2 >= _minSize) {
+        const int w = width / 2;
+        const int h = height / 2;
+        const int stride = width * bpp;
+
+        for (int y = 0; y < h; y++) {
+            const GLubyte* row0 = data + (2 * y) * stride;
+            const GLubyte* row1 = row0 + stride;
+            GLubyte* dst = data + y * w * bpp;
+
+            for (int x = 0; x < w; x++) {
+                for (int c = 0; c < bpp; c++) {
+                    int i = 2 * x * bpp + c;
+                    int sum = row0[i] + row0[i + bpp] + row1[i] + row1[i + bpp];
+                    dst[x * bpp + c] = static_cast<GLubyte>((sum + 2) / 4);
+                }
+            }
+        }
+        width = w;
+        height = h;
+    }
+
+    m_bufferSize = width * height * bpp;
+
+    // Give back the unused part of the allocation
+    if (auto buffer = static_cast<GLubyte*>(std::realloc(data, m_bufferSize))) {
+        m_buffer.release();
+        m_buffer.reset(buffer);
+    }
+
+    resize(width, height);
+
+    return true;
+}
+
 size_t Texture::bpp() const {
     return m_options.bytesPerPixel();
 }
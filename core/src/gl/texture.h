@@ -84,6 +84,12 @@ public:
     // supported by the driver.
     virtual bool bind(RenderState& rs, GLuint _unit);
 
+    // Returns false while pixel data is set that has not been uploaded by bind()
+    bool isUploaded() const { return !m_shouldResize; }
+
+    // GL texture name, zero before the texture is first bound
+    GLuint glHandle() const { return m_glHandle; }
+
     // Width and Height texture getters
     int width() const { return m_width; }
     int height() const { return m_height; }
@@ -99,6 +105,11 @@ public:
     // Resize the texture
     void resize(int width, int height);
 
+    // Halve the resolution of the pixel data with a box filter while both
+    // dimensions stay at least _minSize. Must be called before the texture
+    // is uploaded. Returns true when the pixel data was reduced.
+    bool downsample(int _minSize);
+
 protected:
 
     // Bytes per pixel for current PixelFormat options
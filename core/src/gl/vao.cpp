@@ -8,7 +8,8 @@
 namespace Tangram {
 
 void Vao::initialize(RenderState& rs, ShaderProgram& _program, const VertexOffsets& _vertexOffsets,
-                     VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer) {
+                     VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer,
+                     GLintptr _byteOffset) {
 
     m_glVAOs.resize(_vertexOffsets.size());
 
@@ -37,7 +38,7 @@ void Vao::initialize(RenderState& rs, ShaderProgram& _program, const VertexOffse
         }
 
         // Enable vertex layout on the specified locations
-        _layout.enable(locations, vertexOffset * _layout.getStride());
+        _layout.enable(locations, _byteOffset + vertexOffset * _layout.getStride());
 
         vertexOffset += nVerts;
     }
@@ -16,8 +16,10 @@ class Vao {
 
 public:
 
+    // @_byteOffset offset of the first vertex in _vertexBuffer
     void initialize(RenderState& rs, ShaderProgram& _program, const VertexOffsets& _vertexOffsets,
-                    VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer);
+                    VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer,
+                    GLintptr _byteOffset = 0);
     bool isInitialized();
     void bind(unsigned int _index);
     void unbind();
@@ -10,14 +10,36 @@
 #include "duktape/duktape.h"
 #include "glm/vec2.hpp"
 
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
 namespace Tangram {
 
 const static char INSTANCE_ID[] = "\xff""\xff""obj";
 const static char FUNC_ID[] = "\xff""\xff""fns";
 
+// Duktape does not validate bytecode, truncated or corrupted bytecode can crash
+// duk_load_function(). Bytecode is stored with a header to check it before loading.
+struct BytecodeHeader {
+    // Bytecode of other Duktape versions cannot be loaded
+    uint32_t version;
+    uint32_t size;
+    uint32_t checksum;
+};
+
+static uint32_t bytecodeChecksum(const uint8_t* _data, size_t _size) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < _size; i++) {
+        hash = (hash ^ _data[i]) * 16777619u;
+    }
+    return hash;
+}
+
 DuktapeContext::DuktapeContext() {
-    // Create duktape heap with default allocation functions and custom fatal error handler.
-    _ctx = duk_create_heap(nullptr, nullptr, nullptr, nullptr, fatalErrorHandler);
+    // Create duktape heap with size tracking allocation functions and custom fatal error handler.
+    _ctx = duk_create_heap(heapAlloc, heapRealloc, heapFree, this, fatalErrorHandler);
 
     //// Create global geometry constants
     // TODO make immutable
@@ -110,6 +132,80 @@ bool DuktapeContext::setFunction(JSFunctionIndex index, const std::string& sourc
     return true;
 }
 
+bool DuktapeContext::getFunctionBytecode(JSFunctionIndex index, std::vector<uint8_t>& bytecode) {
+    if (!duk_get_global_string(_ctx, FUNC_ID)) {
+        LOGE("DumpFunction - functions array not initialized");
+        duk_pop(_ctx);
+        return false;
+    }
+
+    // -> [fns, fn|undefined]
+    if (!duk_get_prop_index(_ctx, -1, index) || !duk_is_function(_ctx, -1)) {
+        duk_pop_2(_ctx);
+        return false;
+    }
+
+    // -> [fns, buffer]
+    duk_dump_function(_ctx);
+
+    duk_size_t size = 0;
+    auto data = static_cast<const uint8_t*>(duk_get_buffer(_ctx, -1, &size));
+    BytecodeHeader header{ DUK_VERSION, uint32_t(size), bytecodeChecksum(data, size) };
+    bytecode.resize(sizeof(header));
+    std::memcpy(bytecode.data(), &header, sizeof(header));
+    bytecode.insert(bytecode.end(), data, data + size);
+
+    duk_pop_2(_ctx);
+
+    return size > 0;
+}
+
+bool DuktapeContext::setFunctionBytecode(JSFunctionIndex index, const std::vector<uint8_t>& bytecode) {
+    BytecodeHeader header;
+    if (bytecode.size() <= sizeof(header)) { return false; }
+
+    std::memcpy(&header, bytecode.data(), sizeof(header));
+    const uint8_t* data = bytecode.data() + sizeof(header);
+    size_t size = bytecode.size() - sizeof(header);
+
+    if (header.version != DUK_VERSION) {
+        LOGW("LoadFunction - bytecode of another Duktape version: %u", header.version);
+        return false;
+    }
+    if (header.size != size || header.checksum != bytecodeChecksum(data, size)) {
+        LOGW("LoadFunction - bytecode is truncated or corrupted");
+        return false;
+    }
+
+    if (!duk_get_global_string(_ctx, FUNC_ID)) {
+        LOGE("LoadFunction - functions array not initialized");
+        duk_pop(_ctx);
+        return false;
+    }
+
+    // -> [fns, buffer]
+    auto buffer = duk_push_fixed_buffer(_ctx, size);
+    std::memcpy(buffer, data, size);
+
+    // Errors of invalid bytecode must not reach the fatal error handler
+    // -> [fns, fn|error]
+    auto loadFunction = [](duk_context* ctx, void*) -> duk_ret_t {
+        duk_load_function(ctx);
+        return 1;
+    };
+    if (duk_safe_call(_ctx, loadFunction, nullptr, 1, 1) != DUK_EXEC_SUCCESS) {
+        LOGW("LoadFunction - invalid bytecode: %s", duk_safe_to_string(_ctx, -1));
+        duk_pop_2(_ctx);
+        return false;
+    }
+
+    // -> [fns]
+    duk_put_prop_index(_ctx, -2, index);
+    duk_pop(_ctx);
+
+    return true;
+}
+
 bool DuktapeContext::evaluateBooleanFunction(uint32_t index) {
     if (!evaluateFunction(index)) {
         return false;
@@ -230,6 +326,42 @@ void DuktapeContext::fatalErrorHandler(void*, const char* message) {
     abort();
 }
 
+// Allocations are prefixed by their size, padded to keep the payload aligned
+static constexpr size_t heapHeader = alignof(std::max_align_t);
+
+void* DuktapeContext::heapAlloc(void* userData, duk_size_t size) {
+    if (size == 0) { return nullptr; }
+    auto block = static_cast<char*>(std::malloc(size + heapHeader));
+    if (!block) { return nullptr; }
+    *reinterpret_cast<size_t*>(block) = size;
+    static_cast<DuktapeContext*>(userData)->_heapSize += size;
+    return block + heapHeader;
+}
+
+void* DuktapeContext::heapRealloc(void* userData, void* ptr, duk_size_t size) {
+    if (!ptr) { return heapAlloc(userData, size); }
+    if (size == 0) {
+        heapFree(userData, ptr);
+        return nullptr;
+    }
+    auto context = static_cast<DuktapeContext*>(userData);
+    auto block = static_cast<char*>(ptr) - heapHeader;
+    size_t oldSize = *reinterpret_cast<size_t*>(block);
+    block = static_cast<char*>(std::realloc(block, size + heapHeader));
+    if (!block) { return nullptr; }
+    *reinterpret_cast<size_t*>(block) = size;
+    context->_heapSize += size;
+    context->_heapSize -= oldSize;
+    return block + heapHeader;
+}
+
+void DuktapeContext::heapFree(void* userData, void* ptr) {
+    if (!ptr) { return; }
+    auto block = static_cast<char*>(ptr) - heapHeader;
+    static_cast<DuktapeContext*>(userData)->_heapSize -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
 bool DuktapeContext::evaluateFunction(uint32_t index) {
     // Get all functions (array) in context
     if (!duk_get_global_string(_ctx, FUNC_ID)) {
@@ -7,7 +7,9 @@
 #include "js/JavaScriptFwd.h"
 #include "duktape/duktape.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Tangram {
 
@@ -139,8 +141,18 @@ public:
 
     bool setFunction(JSFunctionIndex index, const std::string& source);
 
+    // Serialize the compiled function at @index, which can be loaded into other contexts.
+    bool getFunctionBytecode(JSFunctionIndex index, std::vector<uint8_t>& bytecode);
+
+    // Set function at @index from bytecode produced by getFunctionBytecode(). Returns
+    // false for invalid bytecode or bytecode of another Duktape version.
+    bool setFunctionBytecode(JSFunctionIndex index, const std::vector<uint8_t>& bytecode);
+
     bool evaluateBooleanFunction(JSFunctionIndex index);
 
+    // Bytes currently allocated by the heap of this context
+    size_t heapSize() const { return _heapSize; }
+
 protected:
     DuktapeValue newNull();
 
@@ -163,6 +175,11 @@ private:
 
     static void fatalErrorHandler(void* userData, const char* message);
 
+    // Heap allocation functions keeping track of heapSize()
+    static void* heapAlloc(void* userData, duk_size_t size);
+    static void* heapRealloc(void* userData, void* ptr, duk_size_t size);
+    static void heapFree(void* userData, void* ptr);
+
     bool evaluateFunction(uint32_t index);
 
     DuktapeValue getStackTopValue() {
@@ -173,6 +190,8 @@ private:
 
     const Feature* _feature = nullptr;
 
+    size_t _heapSize = 0;
+
     friend JavaScriptScope<DuktapeContext>;
 };
 
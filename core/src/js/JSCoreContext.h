@@ -203,8 +203,14 @@ public:
 
     bool setFunction(JSFunctionIndex index, const std::string& source);
 
+    // JavaScriptCore has no API to load precompiled functions, these always return false.
+    bool getFunctionBytecode(JSFunctionIndex, std::vector<uint8_t>&) { return false; }
+    bool setFunctionBytecode(JSFunctionIndex, const std::vector<uint8_t>&) { return false; }
+
     bool evaluateBooleanFunction(JSFunctionIndex index);
 
+    size_t heapSize() const { return 0; }
+
 protected:
 
     JSCoreValue newNull();
@@ -266,8 +266,15 @@ void Map::render() {
 
     glm::vec2 viewport(view.getWidth(), view.getHeight());
 
+    renderState.resetFrameStats();
+
     // Delete batch of gl resources
-    renderState.flushResourceDeletion();
+    renderState.flushResourceDeletion(RenderState::RESOURCE_DELETION_TIME);
+
+    // Render another frame for the deletions left for later
+    if (renderState.pendingDeletions() > 0) {
+        impl->platform.requestRender();
+    }
 
     // Invalidate render states for new frame
     if (!impl->cacheGlState) {
@@ -913,6 +920,10 @@ void Map::onMemoryWarning() {
     if (impl->scene && impl->scene->fontContext()) {
         impl->scene->fontContext()->releaseFonts();
     }
+
+    // Free the resources kept for reuse on the next frame
+    impl->renderState.clearResourcePools();
+    impl->platform.requestRender();
 }
 
 void Map::setDefaultBackgroundColor(float r, float g, float b) {
@@ -0,0 +1,105 @@
+#include "scene/drawList.h"
+
+#include "gl/texture.h"
+#include "marker/marker.h"
+#include "tile/tile.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+
+namespace Tangram {
+
+uint64_t DrawList::sortKey(Blending _blend, int _blendOrder, uint32_t _texture,
+                           uint32_t _style, float _depth) {
+
+    uint64_t key = 0;
+
+    if (_blend == Blending::opaque) {
+        // Opaque draws can be reordered freely, group them by texture
+        // and draw them front to back
+        uint64_t depth = glm::clamp(_depth, 0.f, 1.f) * 0xfff;
+        key |= uint64_t(_texture & 0xffff) << 28;
+        key |= depth;
+    } else {
+        uint64_t order = glm::clamp(_blendOrder, INT16_MIN, INT16_MAX) - INT16_MIN;
+        key |= uint64_t(1) << 63;
+        key |= order << 47;
+    }
+
+    key |= uint64_t(static_cast<uint8_t>(_blend) & 0x7) << 44;
+    key |= uint64_t(_style & 0xffff) << 12;
+
+    return key;
+}
+
+void DrawList::build(const std::vector<std::unique_ptr<Style>>& _styles,
+                     const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    m_items.clear();
+
+    // Distance of the tile centers from the camera, normalized for this frame
+    m_tileDepths.resize(_tiles.size());
+    float maxDepth = 0.f;
+
+    for (size_t i = 0; i < _tiles.size(); i++) {
+        glm::vec4 center = _tiles[i]->mvp() * glm::vec4(0.5f, 0.5f, 0.f, 1.f);
+        m_tileDepths[i] = std::max(center.w, 0.f);
+        maxDepth = std::max(maxDepth, m_tileDepths[i]);
+    }
+    if (maxDepth > 0.f) {
+        for (auto& depth : m_tileDepths) { depth /= maxDepth; }
+    }
+
+    for (uint32_t s = 0; s < _styles.size(); s++) {
+        auto& style = *_styles[s];
+
+        auto* texture = style.texture();
+        uint32_t textureHandle = texture ? texture->glHandle() : 0;
+
+        for (size_t t = 0; t < _tiles.size(); t++) {
+            if (!_tiles[t]->getMesh(style)) { continue; }
+
+            m_items.push_back({ sortKey(style.blendMode(), style.blendOrder(), textureHandle,
+                                        s, m_tileDepths[t]), s, int32_t(t) });
+        }
+
+        // Every style is drawn once per frame, its markers after its tiles
+        m_items.push_back({ sortKey(style.blendMode(), style.blendOrder(), textureHandle, s, 1.f),
+                            s, -1 });
+    }
+
+    // Keep the scene order of styles and tiles with equal keys
+    std::stable_sort(m_items.begin(), m_items.end(),
+                     [](const Item& a, const Item& b) { return a.key < b.key; });
+}
+
+bool DrawList::draw(RenderState& rs, const View& _view,
+                    const std::vector<std::unique_ptr<Style>>& _styles,
+                    const std::vector<std::shared_ptr<Tile>>& _tiles,
+                    const std::vector<std::unique_ptr<Marker>>& _markers) {
+
+    bool drawnAnimatedStyle = false;
+
+    for (size_t i = 0; i < m_items.size();) {
+        uint32_t style = m_items[i].style;
+
+        // The items of a style are adjacent
+        m_styleTiles.clear();
+        for (; i < m_items.size() && m_items[i].style == style; i++) {
+            if (m_items[i].tile >= 0) {
+                m_styleTiles.push_back(_tiles[m_items[i].tile]);
+            }
+        }
+
+        bool styleDrawn = _styles[style]->draw(rs, _view, m_styleTiles, _markers);
+
+        drawnAnimatedStyle |= (styleDrawn && _styles[style]->isAnimated());
+    }
+
+    m_styleTiles.clear();
+
+    return drawnAnimatedStyle;
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "style/style.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+class Marker;
+class RenderState;
+class Tile;
+class View;
+
+/*
+ * DrawList - Orders the draws of a frame by 64 bit sort keys, so that draws sharing a
+ * shader program, textures and blend state are submitted together and opaque tiles
+ * are drawn front to back. Styles with blending keep the order of their blend order.
+ */
+class DrawList {
+
+public:
+
+    struct Item {
+        uint64_t key;
+        // Index of the style in the scene styles
+        uint32_t style;
+        // Index of the tile in the visible tiles, -1 for the item drawing the markers
+        int32_t tile;
+    };
+
+    // Key layout, from the most significant bits:
+    // | blended (1) | blend order (16) | blend mode (3) | texture (16) | style (16) | depth (12) |
+    // Each style has its own shader program, so draws of one style are kept together.
+    // Blended styles do not use texture and depth, their draw order must not change.
+    // @_depth is in the range [0, 1].
+    static uint64_t sortKey(Blending _blend, int _blendOrder, uint32_t _texture,
+                            uint32_t _style, float _depth);
+
+    // Collect and sort the items of @_styles and the @_tiles with meshes of each style
+    void build(const std::vector<std::unique_ptr<Style>>& _styles,
+               const std::vector<std::shared_ptr<Tile>>& _tiles);
+
+    // Draw the items of the last build(), returns true when an animated style was drawn
+    bool draw(RenderState& rs, const View& _view,
+              const std::vector<std::unique_ptr<Style>>& _styles,
+              const std::vector<std::shared_ptr<Tile>>& _tiles,
+              const std::vector<std::unique_ptr<Marker>>& _markers);
+
+    const std::vector<Item>& items() const { return m_items; }
+
+private:
+
+    std::vector<Item> m_items;
+    std::vector<float> m_tileDepths;
+    std::vector<std::shared_ptr<Tile>> m_styleTiles;
+
+};
+
+}
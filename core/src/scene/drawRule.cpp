@@ -34,14 +34,25 @@ std::string DrawRuleData::toString() const {
     return str;
 }
 
-DrawRule::DrawRule(const DrawRuleData& ruleData, const std::string& layerName, int layerDepth) :
+DrawRule::DrawRule(const DrawRuleData& ruleData, const SceneLayer& layer, int layerDepth) :
     name(&ruleData.name),
     id(ruleData.id) {
 
     for (const auto& param : ruleData.parameters) {
         auto key = static_cast<uint8_t>(param.key);
-        active[key] = true;
-        params[key] = { &param, layerName.c_str(), layerDepth };
+        activate(key);
+        params[key] = { &param, layer.name().c_str(), layer.nameHash(), layerDepth };
+    }
+}
+
+void DrawRule::deactivate(uint8_t _key) {
+    if (!active[_key]) { return; }
+    active[_key] = false;
+    for (uint8_t i = 0; i < activeCount; i++) {
+        if (activeKeys[i] == _key) {
+            activeKeys[i] = activeKeys[--activeCount];
+            break;
+        }
     }
 }
 
@@ -53,7 +64,7 @@ bool DrawRule::hasParameterSet(StyleParamKey _key) const {
     return false;
 }
 
-void DrawRule::merge(const DrawRuleData& ruleData, const std::string& layerName, int layerDepth) {
+void DrawRule::merge(const DrawRuleData& ruleData, const SceneLayer& layer, int layerDepth) {
 
     for (const auto& paramNew : ruleData.parameters) {
 
@@ -61,8 +72,8 @@ void DrawRule::merge(const DrawRuleData& ruleData, const std::string& layerName,
         auto& param = params[key];
 
         if (!active[key] || layerDepth > param.layerDepth) {
-            param = { &paramNew, layerName.c_str(), layerDepth };
-            active[key] = true;
+            param = { &paramNew, layer.name().c_str(), layer.nameHash(), layerDepth };
+            activate(key);
         }
     }
 }
@@ -93,7 +104,9 @@ const std::string& DrawRule::getStyleName() const {
 size_t DrawRule::getParamSetHash() const {
     size_t seed = 0;
     for (size_t i = 0; i < StyleParamKeySize; i++) {
-        if (active[i]) { hash_combine(seed, params[i].layerName); }
+        // Hash the name instead of the pointer: TileBuilder matches features
+        // against copies of the scene layers, see SceneLayer::specializeZoom()
+        if (active[i]) { hash_combine(seed, params[i].layerNameHash); }
     }
     return seed;
 }
@@ -114,7 +127,7 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
     }
 
     // If the first filter doesn't match, return immediately
-    if (!_layer.filter().eval(_feature, _ctx)) { return false; }
+    if (!_layer.filterProgram().eval(_feature, _ctx)) { return false; }
 
     m_queuedLayers.push_back({ &_layer, 1 });
 
@@ -129,14 +142,37 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
         // Merge rules from layer into accumulated set
         mergeRules(layer, depth);
 
+        const auto& sublayers = layer.sublayers();
+
         // Push each of the layer's matching sublayers onto the stack
-        for (const auto& sublayer : layer.sublayers()) {
+        if (auto* index = layer.sublayerIndex()) {
+            // Only consider sublayers that can match the feature's value of the
+            // index key. These stay in sublayer order to keep 'exclusive' intact.
+            index->candidates(_feature.props, m_sublayerCandidates);
+
+            for (auto i : m_sublayerCandidates) {
+                const auto& sublayer = sublayers[i];
+                if (!sublayer.enabled()) {
+                    continue;
+                }
+
+                if (index->exact[i] || sublayer.filterProgram().eval(_feature, _ctx)) {
+                    m_queuedLayers.push_back({ &sublayer, depth + 1 });
+                    if (sublayer.exclusive()) {
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+
+        for (const auto& sublayer : sublayers) {
             // Skip matching this sublayer if marked not visible
             if (!sublayer.enabled()) {
                 continue;
             }
 
-            if (sublayer.filter().eval(_feature, _ctx)) {
+            if (sublayer.filterProgram().eval(_feature, _ctx)) {
                 m_queuedLayers.push_back({ &sublayer, depth + 1 });
                 if (sublayer.exclusive()) {
                     break;
@@ -156,13 +192,10 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& cont
     }
 
     bool valid = true;
-    for (size_t i = 0; i < StyleParamKeySize; ++i) {
-
-        if (!rule.active[i]) {
-            rule.params[i].param = nullptr;
-            continue;
-        }
+    // Backwards, as deactivate() moves the last key into the removed position
+    for (size_t n = rule.activeCount; n-- > 0; ) {
 
+        auto i = rule.activeKeys[n];
         auto*& param = rule.params[i].param;
 
         // Evaluate JS functions and Stops
@@ -177,7 +210,7 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& cont
                     valid = false;
                     break;
                 } else {
-                    rule.active[i] = false;
+                    rule.deactivate(i);
                 }
             }
         } else if (param->stops) {
@@ -201,9 +234,9 @@ void DrawRuleMergeSet::mergeRules(const SceneLayer& layer, int depth) {
         }
 
         if (pos == end) {
-            m_matchedRules.emplace_back(rule, layer.name(), depth);
+            m_matchedRules.emplace_back(rule, layer, depth);
         } else {
-            m_matchedRules[pos].merge(rule, layer.name(), depth);
+            m_matchedRules[pos].merge(rule, layer, depth);
         }
     }
 }
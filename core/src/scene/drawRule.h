@@ -2,6 +2,7 @@
 
 #include "scene/styleParam.h"
 
+#include <array>
 #include <bitset>
 #include <vector>
 #include <set>
@@ -59,8 +60,9 @@ struct DrawRule {
     // Function/Stops in DrawRuleMergeset.
     struct {
         const StyleParam* param;
-        // SceneLayer name and depth
+        // SceneLayer name, its hash and depth
         const char* layerName;
+        size_t layerNameHash;
         int layerDepth;
     } params[StyleParamKeySize];
 
@@ -70,6 +72,11 @@ struct DrawRule {
     // 480 (on 32bit arch) or 980 byte for params array.
     std::bitset<StyleParamKeySize> active = { 0 };
 
+    // Keys of the active parameters, unordered. Rules usually set only a few
+    // parameters, so these are iterated instead of testing every key in 'active'.
+    // Use activate() and deactivate() to keep both in sync.
+    std::array<uint8_t, StyleParamKeySize> activeKeys;
+    uint8_t activeCount = 0;
 
     // draw-style name and id
     const std::string* name = nullptr;
@@ -78,12 +85,21 @@ struct DrawRule {
     uint32_t selectionColor = 0;
     FeatureSelection* featureSelection = nullptr;
 
-    DrawRule(const DrawRuleData& ruleData, const std::string& layerName, int layerDepth);
+    DrawRule(const DrawRuleData& ruleData, const SceneLayer& layer, int layerDepth);
 
-    void merge(const DrawRuleData& ruleData, const std::string& layerName, int layerDepth);
+    void merge(const DrawRuleData& ruleData, const SceneLayer& layer, int layerDepth);
 
     bool contains(StyleParamKey _key) const;
 
+    void activate(uint8_t _key) {
+        if (!active[_key]) {
+            active[_key] = true;
+            activeKeys[activeCount++] = _key;
+        }
+    }
+
+    void deactivate(uint8_t _key);
+
     const std::string& getStyleName() const;
 
     size_t getParamSetHash() const;
@@ -132,9 +148,10 @@ private:
         int depth;
     };
 
-    // Reusable containers 'matchedRules' and 'queuedLayers'
+    // Reusable containers 'matchedRules', 'queuedLayers' and 'sublayerCandidates'
     std::vector<DrawRule> m_matchedRules;
     std::vector<LayerMatch> m_queuedLayers;
+    std::vector<uint32_t> m_sublayerCandidates;
 
     // Container for dynamically-evaluated parameters
     StyleParam m_evaluated[StyleParamKeySize];
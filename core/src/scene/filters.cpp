@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "scene/styleContext.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace Tangram {
@@ -284,15 +285,16 @@ struct number_matcher {
 
 struct match_equal_set {
     using result_type = bool;
-    const std::vector<Value>& values;
+    const Value* begin;
+    const Value* end;
 
     template <typename T>
     bool operator()(T) const { return false; }
 
     bool operator()(const double& num) const {
         number_matcher m{num};
-        for (const auto& v : values) {
-            if (Value::visit(v, m)) {
+        for (auto* v = begin; v != end; ++v) {
+            if (Value::visit(*v, m)) {
                 return true;
             }
         }
@@ -301,8 +303,8 @@ struct match_equal_set {
     bool operator()(const std::string& str) const {
         string_matcher m{str};
 
-        for (const auto& v : values) {
-            if (Value::visit(v, m)) {
+        for (auto* v = begin; v != end; ++v) {
+            if (Value::visit(*v, m)) {
                 return true;
             }
         }
@@ -326,11 +328,12 @@ struct match_equal {
 };
 
 struct match_range {
-    const Filter::Range& f;
+    float min;
+    float max;
     double scale;
 
     bool operator() (const double& num) const {
-        return num >= f.min * scale && num < f.max * scale;
+        return num >= min * scale && num < max * scale;
     }
     bool operator() (const std::string&) const { return false; }
     bool operator() (const none_type&) const { return false; }
@@ -375,7 +378,7 @@ struct matcher {
             ? props.get(f.key)
             : ctx.getKeyword(f.keyword);
 
-        return Value::visit(value, match_equal_set{f.values});
+        return Value::visit(value, match_equal_set{f.values.data(), f.values.data() + f.values.size()});
     }
     bool operator() (const Filter::Equality& f) const {
         auto& value = (f.keyword == FilterKeyword::undefined)
@@ -389,7 +392,7 @@ struct matcher {
         auto& value = (f.keyword == FilterKeyword::undefined)
             ? props.get(f.key)
             : ctx.getKeyword(f.keyword);
-        return Value::visit(value, match_range{f, scale});
+        return Value::visit(value, match_range{f.min, f.max, scale});
     }
     bool operator() (const Filter::Function& f) const {
         return ctx.evalFilter(f.id);
@@ -403,4 +406,300 @@ bool Filter::eval(const Feature& feat, StyleContext& ctx) const {
     return Data::visit(data, matcher(feat, ctx));
 }
 
+bool Filter::isFalse() const {
+    return data.is<OperatorAny>() && data.get<OperatorAny>().operands.empty();
+}
+
+Filter Filter::specializeZoom(float _zoom) const {
+    // Zoom keyword value as set by StyleContext::setZoom
+    const Value zoom = double(_zoom);
+
+    switch (data.which()) {
+    case Data::type<OperatorAll>::value: {
+        std::vector<Filter> operands;
+        for (const auto& operand : data.get<OperatorAll>().operands) {
+            auto filter = operand.specializeZoom(_zoom);
+            if (filter.isFalse()) { return filter; }
+            if (filter.isValid()) { operands.push_back(std::move(filter)); }
+        }
+        if (operands.empty()) { return {}; }
+        if (operands.size() == 1) { return std::move(operands[0]); }
+        return MatchAll(std::move(operands));
+    }
+    case Data::type<OperatorAny>::value: {
+        std::vector<Filter> operands;
+        for (const auto& operand : data.get<OperatorAny>().operands) {
+            auto filter = operand.specializeZoom(_zoom);
+            if (!filter.isValid()) { return filter; }
+            if (!filter.isFalse()) { operands.push_back(std::move(filter)); }
+        }
+        if (operands.size() == 1) { return std::move(operands[0]); }
+        return MatchAny(std::move(operands));
+    }
+    case Data::type<OperatorNone>::value: {
+        std::vector<Filter> operands;
+        for (const auto& operand : data.get<OperatorNone>().operands) {
+            auto filter = operand.specializeZoom(_zoom);
+            if (!filter.isValid()) { return MatchAny({}); }
+            if (!filter.isFalse()) { operands.push_back(std::move(filter)); }
+        }
+        if (operands.empty()) { return {}; }
+        return MatchNone(std::move(operands));
+    }
+    case Data::type<Equality>::value: {
+        auto& f = data.get<Equality>();
+        if (f.keyword != FilterKeyword::zoom) { break; }
+        if (Value::visit(zoom, match_equal{f.value})) { return {}; }
+        return MatchAny({});
+    }
+    case Data::type<EqualitySet>::value: {
+        auto& f = data.get<EqualitySet>();
+        if (f.keyword != FilterKeyword::zoom) { break; }
+        const Value* values = f.values.data();
+        if (Value::visit(zoom, match_equal_set{values, values + f.values.size()})) { return {}; }
+        return MatchAny({});
+    }
+    case Data::type<Range>::value: {
+        auto& f = data.get<Range>();
+        if (f.keyword != FilterKeyword::zoom || f.hasPixelArea) { break; }
+        if (Value::visit(zoom, match_range{f.min, f.max, 1.0})) { return {}; }
+        return MatchAny({});
+    }
+    default:
+        break;
+    }
+    return *this;
+}
+
+// Bitmask of GeometryTypes matching a '$geometry' value, as set by StyleContext::setFeature
+static uint32_t geometryMask(const Value& _value) {
+    static const char* geometryStrings[] = { "", "point", "line", "polygon" };
+
+    if (!_value.is<std::string>()) { return 0; }
+
+    const auto& str = _value.get<std::string>();
+    for (uint32_t i = 0; i < 4; i++) {
+        if (str == geometryStrings[i]) { return 1 << i; }
+    }
+    return 0;
+}
+
+FilterProgram::FilterProgram(const Filter& _filter) {
+    if (!_filter.isValid()) { return; }
+
+    compile(_filter);
+    threadJumps();
+}
+
+uint32_t FilterProgram::addKey(const std::string& _key) {
+    auto it = std::find(m_keys.begin(), m_keys.end(), _key);
+    if (it != m_keys.end()) { return it - m_keys.begin(); }
+
+    m_keys.push_back(_key);
+    return m_keys.size() - 1;
+}
+
+uint32_t FilterProgram::addValues(const std::vector<Value>& _values) {
+    uint32_t start = m_values.size();
+    m_values.insert(m_values.end(), _values.begin(), _values.end());
+    return start;
+}
+
+void FilterProgram::compileOperands(const std::vector<Filter>& _operands, Opcode _jump, bool _emptyResult) {
+    if (_operands.empty()) {
+        Instruction in;
+        in.op = Opcode::constant;
+        in.arg = _emptyResult;
+        m_code.push_back(in);
+        return;
+    }
+
+    // Each operand but the last one may decide the result of the operator
+    std::vector<size_t> jumps;
+    for (size_t i = 0; i < _operands.size(); i++) {
+        compile(_operands[i]);
+        if (i + 1 < _operands.size()) {
+            jumps.push_back(m_code.size());
+            Instruction in;
+            in.op = _jump;
+            m_code.push_back(in);
+        }
+    }
+    for (auto jump : jumps) {
+        m_code[jump].arg = m_code.size();
+    }
+}
+
+void FilterProgram::compile(const Filter& _filter) {
+    const auto& data = _filter.data;
+    Instruction in;
+
+    switch (data.which()) {
+    case Filter::Data::type<Filter::OperatorAll>::value:
+        compileOperands(data.get<Filter::OperatorAll>().operands, Opcode::jump_if_false, true);
+        return;
+
+    case Filter::Data::type<Filter::OperatorAny>::value:
+        compileOperands(data.get<Filter::OperatorAny>().operands, Opcode::jump_if_true, false);
+        return;
+
+    case Filter::Data::type<Filter::OperatorNone>::value:
+        compileOperands(data.get<Filter::OperatorNone>().operands, Opcode::jump_if_true, false);
+        in.op = Opcode::negate;
+        break;
+
+    case Filter::Data::type<Filter::Existence>::value: {
+        auto& f = data.get<Filter::Existence>();
+        in.op = Opcode::exists;
+        in.key = addKey(f.key);
+        in.flag = f.exists;
+        break;
+    }
+    case Filter::Data::type<Filter::Equality>::value: {
+        auto& f = data.get<Filter::Equality>();
+        if (f.keyword == FilterKeyword::geometry) {
+            in.op = Opcode::geometry;
+            in.arg = geometryMask(f.value);
+        } else if (f.keyword != FilterKeyword::undefined) {
+            in.op = Opcode::keyword_equal;
+            in.arg = static_cast<uint32_t>(f.keyword);
+            in.value = addValues({ f.value });
+        } else {
+            in.op = Opcode::equal;
+            in.key = addKey(f.key);
+            in.value = addValues({ f.value });
+        }
+        break;
+    }
+    case Filter::Data::type<Filter::EqualitySet>::value: {
+        auto& f = data.get<Filter::EqualitySet>();
+        if (f.keyword == FilterKeyword::geometry) {
+            in.op = Opcode::geometry;
+            for (const auto& value : f.values) { in.arg |= geometryMask(value); }
+        } else {
+            if (f.keyword != FilterKeyword::undefined) {
+                in.op = Opcode::keyword_equal_set;
+                in.arg = static_cast<uint32_t>(f.keyword);
+            } else {
+                in.op = Opcode::equal_set;
+                in.key = addKey(f.key);
+            }
+            in.value = addValues(f.values);
+            in.count = f.values.size();
+        }
+        break;
+    }
+    case Filter::Data::type<Filter::Range>::value: {
+        auto& f = data.get<Filter::Range>();
+        if (f.keyword != FilterKeyword::undefined) {
+            in.op = Opcode::keyword_range;
+            in.arg = static_cast<uint32_t>(f.keyword);
+        } else {
+            in.op = Opcode::range;
+            in.key = addKey(f.key);
+        }
+        in.min = f.min;
+        in.max = f.max;
+        in.flag = f.hasPixelArea;
+        break;
+    }
+    case Filter::Data::type<Filter::Function>::value:
+        in.op = Opcode::function;
+        in.arg = data.get<Filter::Function>().id;
+        break;
+
+    default:
+        in.op = Opcode::constant;
+        in.arg = 1;
+        break;
+    }
+    m_code.push_back(in);
+}
+
+void FilterProgram::threadJumps() {
+    // A jump that lands on another conditional jump knows the outcome of it,
+    // since the result is not modified in between.
+    for (auto& in : m_code) {
+        if (in.op != Opcode::jump_if_true && in.op != Opcode::jump_if_false) { continue; }
+
+        while (in.arg < m_code.size()) {
+            const auto& target = m_code[in.arg];
+            if (target.op == in.op) {
+                in.arg = target.arg;
+            } else if (target.op == Opcode::jump_if_true || target.op == Opcode::jump_if_false) {
+                in.arg += 1;
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+bool FilterProgram::eval(const Feature& _feature, StyleContext& _ctx) const {
+    const auto& props = _feature.props;
+    const size_t size = m_code.size();
+
+    bool result = true;
+    size_t pc = 0;
+
+    while (pc < size) {
+        const auto& in = m_code[pc++];
+
+        switch (in.op) {
+        case Opcode::constant:
+            result = in.arg != 0;
+            break;
+        case Opcode::exists:
+            result = props.contains(m_keys[in.key]) == in.flag;
+            break;
+        case Opcode::equal:
+            result = Value::visit(props.get(m_keys[in.key]), match_equal{m_values[in.value]});
+            break;
+        case Opcode::equal_set: {
+            const Value* values = &m_values[in.value];
+            result = Value::visit(props.get(m_keys[in.key]), match_equal_set{values, values + in.count});
+            break;
+        }
+        case Opcode::range: {
+            double scale = in.flag ? _ctx.getPixelAreaScale() : 1.0;
+            result = Value::visit(props.get(m_keys[in.key]), match_range{in.min, in.max, scale});
+            break;
+        }
+        case Opcode::keyword_equal: {
+            const auto& value = _ctx.getKeyword(static_cast<FilterKeyword>(in.arg));
+            result = Value::visit(value, match_equal{m_values[in.value]});
+            break;
+        }
+        case Opcode::keyword_equal_set: {
+            const auto& value = _ctx.getKeyword(static_cast<FilterKeyword>(in.arg));
+            const Value* values = &m_values[in.value];
+            result = Value::visit(value, match_equal_set{values, values + in.count});
+            break;
+        }
+        case Opcode::keyword_range: {
+            double scale = in.flag ? _ctx.getPixelAreaScale() : 1.0;
+            const auto& value = _ctx.getKeyword(static_cast<FilterKeyword>(in.arg));
+            result = Value::visit(value, match_range{in.min, in.max, scale});
+            break;
+        }
+        case Opcode::geometry:
+            result = (in.arg & (1 << _feature.geometryType)) != 0;
+            break;
+        case Opcode::function:
+            result = _ctx.evalFilter(in.arg);
+            break;
+        case Opcode::jump_if_true:
+            if (result) { pc = in.arg; }
+            break;
+        case Opcode::jump_if_false:
+            if (!result) { pc = in.arg; }
+            break;
+        case Opcode::negate:
+            result = !result;
+            break;
+        }
+    }
+    return result;
+}
+
 }
@@ -72,6 +72,11 @@ struct Filter {
 
     bool eval(const Feature& feat, StyleContext& ctx) const;
 
+    // Returns this filter with all '$zoom' tests replaced by their result at @_zoom and
+    // operators simplified accordingly. The result is an invalid filter when it matches
+    // any feature at @_zoom and isFalse() when it cannot match.
+    Filter specializeZoom(float _zoom) const;
+
     // Create an 'any', 'all', or 'none' filter
     inline static Filter MatchAny(std::vector<Filter> filters) {
         sort(filters);
@@ -115,6 +120,69 @@ struct Filter {
     const std::vector<Filter>& operands() const;
 
     bool isValid() const { return !data.is<none_type>(); }
+    // Whether this is an 'any' filter without operands, which matches nothing
+    bool isFalse() const;
     operator bool() const { return isValid(); }
 };
+
+/* Filter compiled into a flat instruction sequence
+ *
+ * Operators become conditional jumps over their operands, so that evaluation
+ * is a single loop without recursion or variant dispatch on the filter tree.
+ * Property keys and values are stored once per program, and '$geometry'
+ * checks are folded into a bitmask of geometry types.
+ */
+class FilterProgram {
+
+public:
+
+    enum class Opcode : uint8_t {
+        constant,           // result = arg
+        exists,             // result = (property 'key' exists) == flag
+        equal,              // result = property 'key' equals 'value'
+        equal_set,          // result = property 'key' is in 'count' values from 'value'
+        range,              // result = property 'key' is in [min, max), scaled by pixel area if flag
+        keyword_equal,      // same as above for FilterKeyword 'arg'
+        keyword_equal_set,
+        keyword_range,
+        geometry,           // result = geometry type of feature is in bitmask 'arg'
+        function,           // result = scene function 'arg'
+        jump_if_true,       // continue at instruction 'arg' when result is true
+        jump_if_false,      // continue at instruction 'arg' when result is false
+        negate,             // result = !result
+    };
+
+    struct Instruction {
+        Opcode op = Opcode::constant;
+        bool flag = false;
+        uint32_t count = 0;
+        uint32_t arg = 0;
+        uint32_t key = 0;
+        uint32_t value = 0;
+        float min = 0;
+        float max = 0;
+    };
+
+    FilterProgram() = default;
+    explicit FilterProgram(const Filter& _filter);
+
+    // Returns true when there are no instructions, like Filter::eval for an invalid Filter
+    bool eval(const Feature& _feature, StyleContext& _ctx) const;
+
+    const std::vector<Instruction>& instructions() const { return m_code; }
+
+private:
+
+    void compile(const Filter& _filter);
+    void compileOperands(const std::vector<Filter>& _operands, Opcode _jump, bool _emptyResult);
+    void threadJumps();
+
+    uint32_t addKey(const std::string& _key);
+    uint32_t addValues(const std::vector<Value>& _values);
+
+    std::vector<Instruction> m_code;
+    std::vector<std::string> m_keys;
+    std::vector<Value> m_values;
+};
+
 }
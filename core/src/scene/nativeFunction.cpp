@@ -0,0 +1,620 @@
+#include "scene/nativeFunction.h"
+
+#include "data/tileData.h"
+#include "scene/filters.h"
+#include "scene/styleContext.h"
+
+#include "double-conversion.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace Tangram {
+
+using Type = NativeFunction::Result::Type;
+
+static const double_conversion::StringToDoubleConverter s_stringToNumber = {
+    0, 0.0, NAN, "Infinity", "NaN" };
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+
+static bool isIdentifierPart(char c) {
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool isAscii(const std::string& _string) {
+    for (char c : _string) {
+        if (static_cast<unsigned char>(c) >= 0x80) { return false; }
+    }
+    return true;
+}
+
+// Recursive descent parser for the expression subset, following the JS operator precedence.
+// All parse functions return the index of the created node or -1 on failure.
+struct NativeFunction::Parser {
+
+    const char* pos;
+    const char* end;
+    std::vector<Node>& nodes;
+
+    void skipSpace() {
+        while (pos < end && isSpace(*pos)) { pos++; }
+    }
+
+    bool accept(const char* _token) {
+        skipSpace();
+        size_t length = strlen(_token);
+        if (size_t(end - pos) >= length && strncmp(pos, _token, length) == 0) {
+            pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    bool acceptWord(const char* _word) {
+        const char* start = pos;
+        if (accept(_word) && (pos == end || !isIdentifierPart(*pos))) {
+            return true;
+        }
+        pos = start;
+        return false;
+    }
+
+    int add(Op _op, int _a = 0, int _b = 0, int _c = 0) {
+        nodes.emplace_back();
+        nodes.back().op = _op;
+        nodes.back().a = _a;
+        nodes.back().b = _b;
+        nodes.back().c = _c;
+        return int(nodes.size() - 1);
+    }
+
+    int constant(Type _type, bool _boolean = false, double _number = 0) {
+        int node = add(Op::constant);
+        nodes[node].value.type = _type;
+        nodes[node].value.boolean = _boolean;
+        nodes[node].value.number = _number;
+        return node;
+    }
+
+    int function() {
+        if (!acceptWord("function") || !accept("(") || !accept(")") || !accept("{") ||
+            !acceptWord("return")) {
+            return -1;
+        }
+
+        // Automatic semicolon insertion makes 'return' followed by a newline return undefined
+        while (pos < end && isSpace(*pos)) {
+            if (*pos++ == '\n') { return -1; }
+        }
+
+        int root = conditional();
+        if (root < 0) { return -1; }
+
+        accept(";");
+        if (!accept("}")) { return -1; }
+
+        skipSpace();
+        return pos == end ? root : -1;
+    }
+
+    int conditional() {
+        int condition = logicalOr();
+        if (condition < 0 || !accept("?")) { return condition; }
+
+        int a = conditional();
+        if (a < 0 || !accept(":")) { return -1; }
+
+        int b = conditional();
+        if (b < 0) { return -1; }
+
+        return add(Op::conditional, condition, a, b);
+    }
+
+    int logicalOr() {
+        int a = logicalAnd();
+        while (a >= 0 && accept("||")) {
+            int b = logicalAnd();
+            a = b < 0 ? -1 : add(Op::logical_or, a, b);
+        }
+        return a;
+    }
+
+    int logicalAnd() {
+        int a = equality();
+        while (a >= 0 && accept("&&")) {
+            int b = equality();
+            a = b < 0 ? -1 : add(Op::logical_and, a, b);
+        }
+        return a;
+    }
+
+    int equality() {
+        int a = relational();
+        while (a >= 0) {
+            Op op;
+            if (accept("===")) { op = Op::strict_equal; }
+            else if (accept("!==")) { op = Op::strict_not_equal; }
+            else if (accept("==")) { op = Op::equal; }
+            else if (accept("!=")) { op = Op::not_equal; }
+            else { break; }
+
+            int b = relational();
+            a = b < 0 ? -1 : add(op, a, b);
+        }
+        return a;
+    }
+
+    int relational() {
+        int a = additive();
+        while (a >= 0) {
+            Op op;
+            if (accept("<=")) { op = Op::less_equal; }
+            else if (accept(">=")) { op = Op::greater_equal; }
+            else if (accept("<")) { op = Op::less; }
+            else if (accept(">")) { op = Op::greater; }
+            else { break; }
+
+            int b = additive();
+            a = b < 0 ? -1 : add(op, a, b);
+        }
+        return a;
+    }
+
+    int additive() {
+        int a = multiplicative();
+        while (a >= 0) {
+            Op op;
+            if (accept("++") || accept("--")) { return -1; }
+            else if (accept("+")) { op = Op::add; }
+            else if (accept("-")) { op = Op::subtract; }
+            else { break; }
+
+            int b = multiplicative();
+            a = b < 0 ? -1 : add(op, a, b);
+        }
+        return a;
+    }
+
+    int multiplicative() {
+        int a = unary();
+        while (a >= 0) {
+            Op op;
+            if (accept("*")) { op = Op::multiply; }
+            else if (accept("/")) { op = Op::divide; }
+            else if (accept("%")) { op = Op::modulo; }
+            else { break; }
+
+            int b = unary();
+            a = b < 0 ? -1 : add(op, a, b);
+        }
+        return a;
+    }
+
+    int unary() {
+        Op op;
+        if (accept("++") || accept("--")) { return -1; }
+        else if (accept("!")) { op = Op::logical_not; }
+        else if (accept("-")) { op = Op::negate; }
+        else if (accept("+")) { op = Op::to_number; }
+        else { return primary(); }
+
+        int a = unary();
+        return a < 0 ? -1 : add(op, a);
+    }
+
+    int primary() {
+        skipSpace();
+        if (pos == end) { return -1; }
+
+        if (accept("(")) {
+            int a = conditional();
+            return (a < 0 || !accept(")")) ? -1 : a;
+        }
+        if (isDigit(*pos) || (*pos == '.' && pos + 1 < end && isDigit(pos[1]))) {
+            return number();
+        }
+        if (*pos == '\'' || *pos == '"') {
+            int node = constant(Type::string);
+            return string(nodes[node].string) ? node : -1;
+        }
+        if (!isIdentifierStart(*pos)) { return -1; }
+
+        const char* start = pos;
+        while (pos < end && isIdentifierPart(*pos)) { pos++; }
+        std::string identifier(start, pos);
+
+        if (identifier == "true") { return constant(Type::boolean, true); }
+        if (identifier == "false") { return constant(Type::boolean, false); }
+        if (identifier == "null") { return constant(Type::null); }
+        if (identifier == "undefined") { return constant(Type::undefined); }
+
+        if (identifier == "feature") {
+            std::string key;
+            if (accept(".")) {
+                skipSpace();
+                start = pos;
+                while (pos < end && isIdentifierPart(*pos)) { pos++; }
+                if (pos == start || !isIdentifierStart(*start)) { return -1; }
+                key.assign(start, pos);
+            } else if (accept("[")) {
+                skipSpace();
+                if (pos == end || (*pos != '\'' && *pos != '"') || !string(key) || !accept("]")) {
+                    return -1;
+                }
+            } else {
+                return -1;
+            }
+            int node = add(Op::property);
+            nodes[node].string = std::move(key);
+            return node;
+        }
+
+        if (identifier[0] == '$') {
+            FilterKeyword keyword = stringToFilterKeyword(identifier);
+            if (keyword == FilterKeyword::undefined) { return -1; }
+            int node = add(Op::keyword);
+            nodes[node].keyword = keyword;
+            return node;
+        }
+
+        // Any other global, e.g. 'global' or 'Math', is left to the JSContext
+        return -1;
+    }
+
+    int number() {
+        const char* start = pos;
+
+        // Leave hexadecimal, octal and binary literals to the JSContext
+        if (*pos == '0' && pos + 1 < end && pos[1] != 'e' && pos[1] != 'E' &&
+            (isDigit(pos[1]) || isIdentifierStart(pos[1]))) {
+            return -1;
+        }
+
+        while (pos < end && isDigit(*pos)) { pos++; }
+        if (pos < end && *pos == '.') {
+            pos++;
+            while (pos < end && isDigit(*pos)) { pos++; }
+        }
+        if (pos < end && (*pos == 'e' || *pos == 'E')) {
+            pos++;
+            if (pos < end && (*pos == '+' || *pos == '-')) { pos++; }
+            if (pos == end || !isDigit(*pos)) { return -1; }
+            while (pos < end && isDigit(*pos)) { pos++; }
+        }
+        if (pos < end && isIdentifierPart(*pos)) { return -1; }
+
+        int processed = 0;
+        double value = s_stringToNumber.StringToDouble(start, int(pos - start), &processed);
+        return constant(Type::number, false, value);
+    }
+
+    bool string(std::string& _result) {
+        char quote = *pos++;
+        while (pos < end && *pos != quote) {
+            char c = *pos++;
+            if (c == '\n' || c == '\r') { return false; }
+            if (c == '\\') {
+                if (pos == end) { return false; }
+                switch (*pos++) {
+                    case '\\': c = '\\'; break;
+                    case '\'': c = '\''; break;
+                    case '"': c = '"'; break;
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    // Unicode, hex and other escapes are left to the JSContext
+                    default: return false;
+                }
+            }
+            _result += c;
+        }
+        if (pos == end) { return false; }
+        pos++;
+        return true;
+    }
+};
+
+bool NativeFunction::compile(const std::string& _source) {
+
+    m_nodes.clear();
+
+    Parser parser{ _source.data(), _source.data() + _source.size(), m_nodes };
+    int root = parser.function();
+
+    if (root < 0) {
+        m_nodes.clear();
+        return false;
+    }
+    m_root = uint32_t(root);
+
+    // Point string constants to their nodes, now that nodes are not moved anymore
+    for (auto& node : m_nodes) {
+        if (node.op == Op::constant && node.value.type == Type::string) {
+            node.value.string = &node.string;
+        }
+    }
+    return true;
+}
+
+bool NativeFunction::evalRoot(const Feature& _feature, const StyleContext& _ctx, Operand& _result) {
+    if (m_nodes.empty()) { return false; }
+
+    m_feature = &_feature;
+    m_ctx = &_ctx;
+    m_strings.clear();
+
+    return eval(m_root, _result);
+}
+
+bool NativeFunction::eval(const Feature& _feature, const StyleContext& _ctx, Result& _result) {
+    Operand value;
+    if (!evalRoot(_feature, _ctx, value)) { return false; }
+
+    _result.type = value.type;
+    _result.boolean = value.boolean;
+    _result.number = value.number;
+    if (value.type == Type::string) {
+        _result.string = *value.string;
+    }
+    return true;
+}
+
+bool NativeFunction::eval(const Feature& _feature, const StyleContext& _ctx, bool& _result) {
+    Operand value;
+    if (!evalRoot(_feature, _ctx, value)) { return false; }
+
+    _result = truthy(value);
+    return true;
+}
+
+bool NativeFunction::truthy(const Operand& _value) {
+    switch (_value.type) {
+        case Type::boolean: return _value.boolean;
+        case Type::number: return _value.number != 0 && !std::isnan(_value.number);
+        case Type::string: return !_value.string->empty();
+        default: return false;
+    }
+}
+
+bool NativeFunction::toNumber(const Operand& _value, double& _result) {
+    switch (_value.type) {
+        case Type::undefined: _result = NAN; return true;
+        case Type::null: _result = 0; return true;
+        case Type::boolean: _result = _value.boolean ? 1 : 0; return true;
+        case Type::number: _result = _value.number; return true;
+        case Type::string: break;
+    }
+
+    const std::string& string = *_value.string;
+
+    // Unicode whitespace and non-decimal literals are left to the JSContext
+    if (!isAscii(string)) { return false; }
+
+    size_t start = 0, end = string.size();
+    while (start < end && isSpace(string[start])) { start++; }
+    while (end > start && isSpace(string[end - 1])) { end--; }
+
+    if (end - start > 1 && string[start] == '0' && string[start + 1] != '\0' &&
+        strchr("xXoObB", string[start + 1])) {
+        return false;
+    }
+
+    int processed = 0;
+    _result = s_stringToNumber.StringToDouble(string.data() + start, int(end - start), &processed);
+    return true;
+}
+
+bool NativeFunction::toString(const Operand& _value, std::string& _result) {
+    switch (_value.type) {
+        case Type::undefined: _result += "undefined"; return true;
+        case Type::null: _result += "null"; return true;
+        case Type::boolean: _result += _value.boolean ? "true" : "false"; return true;
+        case Type::string: _result += *_value.string; return true;
+        case Type::number: break;
+    }
+
+    char buffer[32];
+    double_conversion::StringBuilder builder(buffer, sizeof(buffer));
+    if (!double_conversion::DoubleToStringConverter::EcmaScriptConverter().ToShortest(_value.number, &builder)) {
+        return false;
+    }
+    _result += builder.Finalize();
+    return true;
+}
+
+bool NativeFunction::strictEquals(const Operand& _a, const Operand& _b) {
+    if (_a.type != _b.type) { return false; }
+
+    switch (_a.type) {
+        case Type::boolean: return _a.boolean == _b.boolean;
+        case Type::number: return _a.number == _b.number;
+        case Type::string: return *_a.string == *_b.string;
+        default: return true;
+    }
+}
+
+bool NativeFunction::looseEquals(const Operand& _a, const Operand& _b, bool& _result) {
+    if (_a.type == _b.type) {
+        _result = strictEquals(_a, _b);
+        return true;
+    }
+
+    bool aNullish = _a.type == Type::undefined || _a.type == Type::null;
+    bool bNullish = _b.type == Type::undefined || _b.type == Type::null;
+    if (aNullish || bNullish) {
+        _result = aNullish && bNullish;
+        return true;
+    }
+
+    // Remaining combinations of boolean, number and string compare as numbers
+    double a, b;
+    if (!toNumber(_a, a) || !toNumber(_b, b)) { return false; }
+
+    _result = a == b;
+    return true;
+}
+
+bool NativeFunction::eval(uint32_t _node, Operand& _result) {
+
+    const Node& node = m_nodes[_node];
+
+    switch (node.op) {
+        case Op::constant:
+            _result = node.value;
+            return true;
+
+        case Op::property: {
+            const auto& value = m_feature->props.get(node.string);
+            _result = Operand{};
+            if (value.is<std::string>()) {
+                _result.type = Type::string;
+                _result.string = &value.get<std::string>();
+            } else if (value.is<double>()) {
+                _result.type = Type::number;
+                _result.number = value.get<double>();
+            }
+            return true;
+        }
+
+        case Op::keyword: {
+            // Unset keywords are not defined in the JSContext either
+            const auto& value = m_ctx->getKeyword(node.keyword);
+            _result = Operand{};
+            if (value.is<std::string>()) {
+                _result.type = Type::string;
+                _result.string = &value.get<std::string>();
+            } else if (value.is<double>()) {
+                _result.type = Type::number;
+                _result.number = value.get<double>();
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        case Op::logical_and:
+            if (!eval(node.a, _result)) { return false; }
+            return !truthy(_result) || eval(node.b, _result);
+
+        case Op::logical_or:
+            if (!eval(node.a, _result)) { return false; }
+            return truthy(_result) || eval(node.b, _result);
+
+        case Op::conditional:
+            if (!eval(node.a, _result)) { return false; }
+            return eval(truthy(_result) ? node.b : node.c, _result);
+
+        case Op::logical_not:
+            if (!eval(node.a, _result)) { return false; }
+            _result.boolean = !truthy(_result);
+            _result.type = Type::boolean;
+            return true;
+
+        case Op::negate:
+        case Op::to_number: {
+            double value;
+            if (!eval(node.a, _result) || !toNumber(_result, value)) { return false; }
+            _result.type = Type::number;
+            _result.number = node.op == Op::negate ? -value : value;
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    // Binary operators
+    Operand a, b;
+    if (!eval(node.a, a) || !eval(node.b, b)) { return false; }
+
+    switch (node.op) {
+        case Op::equal:
+        case Op::not_equal: {
+            bool equal;
+            if (!looseEquals(a, b, equal)) { return false; }
+            _result.type = Type::boolean;
+            _result.boolean = (node.op == Op::equal) == equal;
+            return true;
+        }
+
+        case Op::strict_equal:
+        case Op::strict_not_equal:
+            _result.type = Type::boolean;
+            _result.boolean = (node.op == Op::strict_equal) == strictEquals(a, b);
+            return true;
+
+        case Op::less:
+        case Op::less_equal:
+        case Op::greater:
+        case Op::greater_equal: {
+            _result.type = Type::boolean;
+
+            if (a.type == Type::string && b.type == Type::string) {
+                // JS compares UTF-16 code units, which only matches the byte order for ASCII
+                if (!isAscii(*a.string) || !isAscii(*b.string)) { return false; }
+                int cmp = a.string->compare(*b.string);
+                switch (node.op) {
+                    case Op::less: _result.boolean = cmp < 0; break;
+                    case Op::less_equal: _result.boolean = cmp <= 0; break;
+                    case Op::greater: _result.boolean = cmp > 0; break;
+                    default: _result.boolean = cmp >= 0; break;
+                }
+                return true;
+            }
+
+            double x, y;
+            if (!toNumber(a, x) || !toNumber(b, y)) { return false; }
+            // Comparisons with NaN are false
+            switch (node.op) {
+                case Op::less: _result.boolean = x < y; break;
+                case Op::less_equal: _result.boolean = x <= y; break;
+                case Op::greater: _result.boolean = x > y; break;
+                default: _result.boolean = x >= y; break;
+            }
+            return true;
+        }
+
+        case Op::add:
+            if (a.type == Type::string || b.type == Type::string) {
+                m_strings.emplace_back();
+                auto& string = m_strings.back();
+                if (!toString(a, string) || !toString(b, string)) { return false; }
+                _result.type = Type::string;
+                _result.string = &string;
+                return true;
+            }
+            // fall through
+        case Op::subtract:
+        case Op::multiply:
+        case Op::divide:
+        case Op::modulo: {
+            double x, y;
+            if (!toNumber(a, x) || !toNumber(b, y)) { return false; }
+            _result.type = Type::number;
+            switch (node.op) {
+                case Op::add: _result.number = x + y; break;
+                case Op::subtract: _result.number = x - y; break;
+                case Op::multiply: _result.number = x * y; break;
+                case Op::divide: _result.number = x / y; break;
+                default: _result.number = std::fmod(x, y); break;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+}
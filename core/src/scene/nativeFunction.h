@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+class StyleContext;
+struct Feature;
+enum class FilterKeyword : uint8_t;
+
+/*
+ * NativeFunction evaluates simple JS filter and style functions without the JS engine.
+ *
+ * Functions consisting of a single return statement are compiled when the returned expression
+ * only contains literals, feature properties, the $zoom, $geometry and $meters_per_pixel keywords
+ * and comparison, logical, arithmetic or conditional operators, e.g.
+ *
+ *   function() { return feature.height > 20 && $zoom > 15; }
+ *
+ * Operators follow JS semantics for the value types that can occur in such expressions. Other
+ * functions are not compiled and must be evaluated by the JSContext, as well as evaluations that
+ * would depend on JS behavior not implemented here (see eval()).
+ */
+class NativeFunction {
+
+public:
+
+    struct Result {
+        enum class Type : uint8_t { undefined, null, boolean, number, string };
+
+        Type type = Type::undefined;
+        bool boolean = false;
+        double number = 0;
+        std::string string;
+    };
+
+    // Returns false when @_source is not a function that can be evaluated natively
+    bool compile(const std::string& _source);
+
+    // Evaluate the function for @_feature and the keywords of @_ctx. Returns false when the
+    // result can only be determined by the JSContext, e.g. when a keyword is not set or
+    // strings with non-ASCII characters are compared or converted to numbers.
+    bool eval(const Feature& _feature, const StyleContext& _ctx, Result& _result);
+
+    // Same as above for the "truthiness" of the result, as used for filter functions
+    bool eval(const Feature& _feature, const StyleContext& _ctx, bool& _result);
+
+private:
+
+    enum class Op : uint8_t {
+        constant,
+        property,
+        keyword,
+        logical_and,
+        logical_or,
+        conditional,
+        logical_not,
+        negate,
+        to_number,
+        equal,
+        not_equal,
+        strict_equal,
+        strict_not_equal,
+        less,
+        less_equal,
+        greater,
+        greater_equal,
+        add,
+        subtract,
+        multiply,
+        divide,
+        modulo,
+    };
+
+    // Value of an evaluated node, strings point to node constants,
+    // feature properties or strings created during evaluation
+    struct Operand {
+        Result::Type type = Result::Type::undefined;
+        bool boolean = false;
+        double number = 0;
+        const std::string* string = nullptr;
+    };
+
+    struct Node {
+        Op op = Op::constant;
+        FilterKeyword keyword;
+        // Operand nodes
+        uint32_t a = 0, b = 0, c = 0;
+        // Constant value or property name
+        Operand value;
+        std::string string;
+    };
+
+    struct Parser;
+
+    bool eval(uint32_t _node, Operand& _result);
+    bool evalRoot(const Feature& _feature, const StyleContext& _ctx, Operand& _result);
+
+    static bool truthy(const Operand& _value);
+    static bool toNumber(const Operand& _value, double& _result);
+    static bool toString(const Operand& _value, std::string& _result);
+    static bool looseEquals(const Operand& _a, const Operand& _b, bool& _result);
+    static bool strictEquals(const Operand& _a, const Operand& _b);
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root = 0;
+
+    // Strings created by '+' during the current evaluation
+    std::deque<std::string> m_strings;
+
+    const Feature* m_feature = nullptr;
+    const StyleContext* m_ctx = nullptr;
+};
+
+}
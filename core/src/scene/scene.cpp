@@ -11,6 +11,7 @@
 #include "scene/sceneLoader.h"
 #include "scene/spriteAtlas.h"
 #include "scene/stops.h"
+#include "scene/styleContext.h"
 #include "selection/featureSelection.h"
 #include "selection/selectionQuery.h"
 #include "style/material.h"
@@ -185,6 +186,10 @@ bool Scene::load() {
     m_layers = SceneLoader::applyLayers(m_config["layers"], m_jsFunctions, m_stops, m_names);
     LOGTO("<<< applyLayers");
 
+    // Compile functions once for the StyleContexts of all TileWorkers
+    size_t bytecodeSize = StyleContext::compileFunctions(m_jsFunctions, m_jsFunctionBytecode);
+    LOGTO("<<< compileFunctions: %d functions, %d bytes", int(m_jsFunctions.size()), int(bytecodeSize));
+
     for (auto& style : m_styles) { style->build(*this); }
     LOGTO("<<< buildStyles");
 
@@ -540,16 +545,17 @@ void Scene::renderBeginFrame(RenderState& _rs) {
 
 bool Scene::render(RenderState& _rs, View& _view) {
 
-    bool drawnAnimatedStyle = false;
-    for (const auto& style : m_styles) {
+    // Upload new tiles within the budget of this frame and continue
+    // rendering until the tiles waiting for upload are drawn
+    if (m_tileManager->uploadTiles(_rs, _view)) {
+        m_platform.requestRender();
+    }
 
-        bool styleDrawn = style->draw(_rs, _view,
-                                      m_tileManager->getVisibleTiles(),
-                                      m_markerManager->markers());
+    // Sort the draws of this frame to minimize GL state changes
+    const auto& tiles = m_tileManager->getVisibleTiles();
+    m_drawList.build(m_styles, tiles);
 
-        drawnAnimatedStyle |= (styleDrawn && style->isAnimated());
-    }
-    return drawnAnimatedStyle;
+    return m_drawList.draw(_rs, _view, m_styles, tiles, m_markerManager->markers());
 }
 
 void Scene::renderSelection(RenderState& _rs, View& _view, FrameBuffer& _selectionBuffer,
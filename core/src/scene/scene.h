@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "stops.h"
 #include "sceneOptions.h"
+#include "scene/drawList.h"
 #include "text/fontContext.h" // For FontDescription
 #include "tile/tileManager.h"
 #include "util/color.h"
@@ -50,6 +51,9 @@ struct SceneCamera : public Camera {
 
 using SceneFunctions = std::vector<std::string>;
 
+/// Compiled SceneFunctions, empty entries for functions that must be compiled from source
+using SceneFunctionBytecode = std::vector<std::vector<uint8_t>>;
+
 using SceneStops = std::list<Stops>;
 
 using DrawRuleNames = std::vector<std::string>;
@@ -111,6 +115,7 @@ public:
 
     const auto& config() const { return m_config; }
     const auto& functions() const { return m_jsFunctions; }
+    const auto& functionBytecode() const { return m_jsFunctionBytecode; }
     const auto& layers() const { return m_layers; }
     const auto& lightBlocks() const { return m_lightShaderBlocks; }
     const auto& lights() const { return m_lights; }
@@ -214,6 +219,9 @@ protected:
     TileSources m_tileSources;
     Styles m_styles;
 
+    /// Draw order of the styles and tiles of a frame
+    DrawList m_drawList;
+
     Lights m_lights;
     LightShaderBlocks m_lightShaderBlocks;
 
@@ -229,6 +237,7 @@ protected:
     DrawRuleNames m_names;
 
     SceneFunctions m_jsFunctions;
+    SceneFunctionBytecode m_jsFunctionBytecode;
     SceneStops m_stops;
 
     Color m_background;
@@ -1,17 +1,75 @@
 #include "scene/sceneLayer.h"
 
+#include "data/properties.h"
+
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 
 namespace Tangram {
 
 static_assert(std::is_move_constructible<SceneLayer>::value, "check");
 
+// Minimum number of siblings filtering on the same key to build a SublayerIndex
+static constexpr size_t minIndexedSublayers = 4;
+
+// Returns the key and string values of a property equality test, when _filter
+// can only pass for these values. Sets _exact when the test is the whole filter.
+static bool equalityValues(const Filter& _filter, const std::string*& _key,
+                           std::vector<const std::string*>& _values, bool& _exact) {
+
+    const auto& data = _filter.data;
+    _values.clear();
+
+    if (data.is<Filter::Equality>()) {
+        auto& f = data.get<Filter::Equality>();
+        if (f.keyword != FilterKeyword::undefined || !f.value.is<std::string>()) { return false; }
+        _key = &f.key;
+        _values.push_back(&f.value.get<std::string>());
+        _exact = true;
+        return true;
+    }
+    if (data.is<Filter::EqualitySet>()) {
+        auto& f = data.get<Filter::EqualitySet>();
+        if (f.keyword != FilterKeyword::undefined) { return false; }
+        for (const auto& value : f.values) {
+            if (!value.is<std::string>()) { return false; }
+            _values.push_back(&value.get<std::string>());
+        }
+        _key = &f.key;
+        _exact = true;
+        return !_values.empty();
+    }
+    if (data.is<Filter::OperatorAll>()) {
+        // Any operand of 'all' must pass: Use the first equality test
+        for (const auto& operand : data.get<Filter::OperatorAll>().operands) {
+            bool exact = false;
+            if (equalityValues(operand, _key, _values, exact)) {
+                _exact = false;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// FNV-1a hash of a layer name, used by DrawRule::getParamSetHash()
+static size_t hashName(const std::string& _name) {
+    uint32_t hash = 2166136261u;
+    for (char c : _name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
 SceneLayer::SceneLayer(std::string name, Filter filter,
                        std::vector<DrawRuleData> rules,
                        std::vector<SceneLayer> sublayers,
                        Options options) :
     m_filter(std::move(filter)),
+    m_filterProgram(m_filter),
     m_name(std::move(name)),
+    m_nameHash(hashName(m_name)),
     m_rules(std::move(rules)),
     m_sublayers(std::move(sublayers)),
     m_options(options) {
@@ -33,6 +91,90 @@ SceneLayer::SceneLayer(std::string name, Filter filter,
                   // first.
                   return a.name() > b.name();
               });
+
+    buildSublayerIndex();
+}
+
+std::unique_ptr<SceneLayer> SceneLayer::specializeZoom(float _zoom) const {
+    if (!enabled()) { return nullptr; }
+
+    auto filter = m_filter.specializeZoom(_zoom);
+    if (filter.isFalse()) { return nullptr; }
+
+    std::vector<SceneLayer> sublayers;
+    for (const auto& sublayer : m_sublayers) {
+        auto specialized = sublayer.specializeZoom(_zoom);
+        if (!specialized) { continue; }
+
+        // Matching a layer without rules has no effect, unless it excludes its siblings
+        if (specialized->rules().empty() && specialized->sublayers().empty() && !sublayer.exclusive()) {
+            continue;
+        }
+
+        bool matchesAll = !specialized->filter().isValid();
+        sublayers.push_back(std::move(*specialized));
+
+        // Siblings after an exclusive layer that always matches are never reached
+        if (matchesAll && sublayer.exclusive()) { break; }
+    }
+
+    return std::make_unique<SceneLayer>(m_name, std::move(filter), m_rules, std::move(sublayers), m_options);
+}
+
+void SceneLayer::buildSublayerIndex() {
+    if (m_sublayers.size() < minIndexedSublayers) { return; }
+
+    // Find the key that most siblings test for equality
+    std::unordered_map<std::string, size_t> keyCount;
+    const std::string* key = nullptr;
+    std::vector<const std::string*> values;
+    bool exact = false;
+
+    for (const auto& sublayer : m_sublayers) {
+        if (equalityValues(sublayer.filter(), key, values, exact)) {
+            keyCount[*key]++;
+        }
+    }
+
+    auto best = std::max_element(keyCount.begin(), keyCount.end(),
+                                 [](const auto& a, const auto& b) { return a.second < b.second; });
+
+    if (best == keyCount.end() || best->second < minIndexedSublayers) { return; }
+
+    auto index = std::make_shared<SublayerIndex>();
+    index->key = best->first;
+    index->exact.resize(m_sublayers.size(), false);
+
+    for (uint32_t i = 0; i < m_sublayers.size(); i++) {
+        if (!equalityValues(m_sublayers[i].filter(), key, values, exact) || *key != index->key) {
+            index->unkeyed.push_back(i);
+            continue;
+        }
+        index->exact[i] = exact;
+        for (const auto* value : values) {
+            auto& entries = index->keyed[*value];
+            // A value may be listed twice in one set
+            if (entries.empty() || entries.back() != i) { entries.push_back(i); }
+        }
+    }
+
+    m_sublayerIndex = std::move(index);
+}
+
+void SceneLayer::SublayerIndex::candidates(const Properties& _props, std::vector<uint32_t>& _out) const {
+    _out.clear();
+
+    const auto& value = _props.get(key);
+    if (value.is<std::string>()) {
+        auto it = keyed.find(value.get<std::string>());
+        if (it != keyed.end()) {
+            std::merge(unkeyed.begin(), unkeyed.end(),
+                       it->second.begin(), it->second.end(),
+                       std::back_inserter(_out));
+            return;
+        }
+    }
+    _out.assign(unkeyed.begin(), unkeyed.end());
 }
 
 }
@@ -3,15 +3,34 @@
 #include "scene/drawRule.h"
 #include "scene/filters.h"
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Tangram {
 
+struct Properties;
+
 class SceneLayer {
 
 public:
 
+    // Index of sublayers by the value of a property, for siblings that filter
+    // on equality with the same key, e.g. 'kind: X'.
+    struct SublayerIndex {
+        std::string key;
+        // Sublayers that do not filter on 'key' and are always candidates
+        std::vector<uint32_t> unkeyed;
+        // Sublayers that can only match the given value of 'key'
+        std::unordered_map<std::string, std::vector<uint32_t>> keyed;
+        // Whether the filter of a sublayer is decided by the index alone
+        std::vector<bool> exact;
+
+        // Write the sublayers that may match _props to _out, in sublayer order
+        void candidates(const Properties& _props, std::vector<uint32_t>& _out) const;
+    };
+
     struct Options {
         Options() = default;
         int priority = std::numeric_limits<int>::max();
@@ -25,20 +44,34 @@ public:
                Options options);
 
     const auto& name() const { return m_name; }
+    // Hash of the name, equal for layers copied by specializeZoom()
+    size_t nameHash() const { return m_nameHash; }
     const auto& filter() const { return m_filter; }
+    const auto& filterProgram() const { return m_filterProgram; }
     const auto& rules() const { return m_rules; }
     const auto& sublayers() const { return m_sublayers; }
+    const SublayerIndex* sublayerIndex() const { return m_sublayerIndex.get(); }
     auto priority() const { return m_options.priority; }
     auto enabled() const { return m_options.enabled; }
     auto exclusive() const { return m_options.exclusive; }
 
+    // Returns a copy of this layer for matching features at @_zoom only: '$zoom' filters
+    // are folded into constants and sublayers that cannot match are removed. Returns null
+    // when the layer itself cannot match at @_zoom.
+    std::unique_ptr<SceneLayer> specializeZoom(float _zoom) const;
+
 private:
 
     Filter m_filter;
+    FilterProgram m_filterProgram;
     std::string m_name;
+    size_t m_nameHash;
     std::vector<DrawRuleData> m_rules;
     std::vector<SceneLayer> m_sublayers;
+    std::shared_ptr<const SublayerIndex> m_sublayerIndex;
     Options m_options;
+
+    void buildSublayerIndex();
 };
 
 }
@@ -841,7 +841,15 @@ std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const s
                 LOGW("Invalid texture filtering: %s", Dump(filtering).c_str());
             }
         }
-        sourcePtr = std::make_shared<RasterSource>(_name, std::move(rawSources), options, zoomOptions);
+        auto rasterSource = std::make_shared<RasterSource>(_name, std::move(rawSources), options, zoomOptions);
+        rasterSource->setCacheSize(_options.rasterTextureCacheSize);
+        if (const Node& downsample = _source["downsample"]) {
+            bool value = false;
+            if (YamlUtil::getBool(downsample, value)) {
+                rasterSource->setDownsampling(value);
+            }
+        }
+        sourcePtr = std::move(rasterSource);
     } else {
         sourcePtr = std::make_shared<TileSource>(_name, std::move(rawSources), zoomOptions);
 
@@ -1008,6 +1016,22 @@ void SceneLoader::loadStyleProps(const Node& _styleNode, Style& _style, SceneTex
         }
     }
 
+    if (const Node& batchNode = _styleNode["batch_tiles"]) {
+        bool boolValue;
+        if (YamlUtil::getBool(batchNode, boolValue)) {
+            _style.setBatchTiles(boolValue);
+        }
+    }
+
+    if (const Node& simplifyNode = _styleNode["simplify"]) {
+        float pixels;
+        if (YamlUtil::getFloat(simplifyNode, pixels) && pixels >= 0.f) {
+            _style.setSimplifyTolerance(pixels);
+        } else {
+            LOGW("Invalid simplify tolerance: %s", Dump(simplifyNode).c_str());
+        }
+    }
+
     if (const Node& dashNode = _styleNode["dash"]) {
         if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&_style)) {
             if (dashNode.IsSequence()) {
@@ -1025,6 +1049,15 @@ void SceneLoader::loadStyleProps(const Node& _styleNode, Style& _style, SceneTex
         }
     }
 
+    if (const Node& cullNode = _styleNode["cull_shared_walls"]) {
+        if (auto polygonStyle = dynamic_cast<PolygonStyle*>(&_style)) {
+            bool boolValue;
+            if (YamlUtil::getBool(cullNode, boolValue)) {
+                polygonStyle->setCullSharedWalls(boolValue);
+            }
+        }
+    }
+
     if (const Node& dashBackgroundColor = _styleNode["dash_background_color"]) {
         if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&_style)) {
             glm::vec4 backgroundColor = YamlUtil::getColorAsVec4(dashBackgroundColor);
@@ -1123,23 +1156,21 @@ void SceneLoader::parseStyleParams(const Node& _params, const std::string& _pref
 
                     if (StyleParam::isColor(styleKey)) {
                         _stops.push_back(Stops::Colors(value));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
                     } else if (StyleParam::isSize(styleKey)) {
                         _stops.push_back(Stops::Sizes(value, StyleParam::unitSetForStyleParam(styleKey)));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
                     } else if (StyleParam::isWidth(styleKey)) {
                         _stops.push_back(Stops::Widths(value, StyleParam::unitSetForStyleParam(styleKey)));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
                     } else if (StyleParam::isOffsets(styleKey)) {
                         _stops.push_back(Stops::Offsets(value, StyleParam::unitSetForStyleParam(styleKey)));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
                     } else if (StyleParam::isFontSize(styleKey)) {
                         _stops.push_back(Stops::FontSize(value));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
                     } else if (StyleParam::isNumberType(styleKey)) {
                         _stops.push_back(Stops::Numbers(value));
-                        _out.push_back(StyleParam{ styleKey, &_stops.back() });
+                    } else {
+                        break;
                     }
+                    _stops.back().buildLookup(styleKey);
+                    _out.push_back(StyleParam{ styleKey, &_stops.back() });
                 } else {
                     LOGW("Unknown style parameter %s", key.c_str());
                 }
@@ -7,6 +7,7 @@
 #include "util/mapProjection.h"
 
 #include <algorithm>
+#include <cmath>
 #include "csscolorparser.hpp"
 #include "yaml-cpp/yaml.h"
 
@@ -413,6 +414,25 @@ auto Stops::nearestHigherFrame(float _key) const -> std::vector<Frame>::const_it
                             [](const Frame& f, float z) { return f.key < z; });
 }
 
+// Highest zoom level of Stops lookup tables
+static const int maxLookupZoom = 24;
+
+void Stops::buildLookup(StyleParamKey _key) {
+    lookup.clear();
+    lookupKey = StyleParamKey::none;
+
+    if (frames.empty() || StyleParam::isSize(_key)) { return; }
+
+    // Zoom levels above the last frame evaluate to the last value
+    int maxZoom = std::min(std::max(int(std::ceil(frames.back().key)), 0), maxLookupZoom);
+
+    lookup.resize(maxZoom + 1);
+    for (int z = 0; z <= maxZoom; z++) {
+        eval(*this, _key, z, lookup[z]);
+    }
+    lookupKey = _key;
+}
+
 void Stops::eval(const Stops& _stops, StyleParamKey _key, float _zoom, StyleParam::Value& _result) {
 
     /* StyleParam::size stops can not have a generic evaluation, and
@@ -420,6 +440,20 @@ void Stops::eval(const Stops& _stops, StyleParamKey _key, float _zoom, StylePara
      */
     if (StyleParam::isSize(_key)) { return; }
 
+    if (_key == _stops.lookupKey && _zoom >= 0 && _zoom == std::floor(_zoom)) {
+        auto& lookup = _stops.lookup;
+        size_t z = _zoom;
+        if (z < lookup.size()) {
+            _result = lookup[z];
+            return;
+        }
+        // The table ends at the last frame, unless that is above maxLookupZoom
+        if (_stops.frames.back().key <= maxLookupZoom && _zoom >= _stops.frames.back().key) {
+            _result = lookup.back();
+            return;
+        }
+    }
+
     if (StyleParam::isColor(_key)) {
         _result = _stops.evalColor(_zoom);
     } else if (StyleParam::isWidth(_key)) {
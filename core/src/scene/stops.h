@@ -29,6 +29,11 @@ struct Stops {
     };
 
     std::vector<Frame> frames;
+
+    // Results of eval() for 'lookupKey' at integer zoom levels, see buildLookup()
+    std::vector<StyleParam::Value> lookup;
+    StyleParamKey lookupKey = StyleParamKey::none;
+
     static Stops Colors(const YAML::Node& _node);
     static Stops Widths(const YAML::Node& _node, UnitSet _units);
     static Stops FontSize(const YAML::Node& _node);
@@ -48,6 +53,10 @@ struct Stops {
     auto evalSize(float _key, const glm::vec2& cssSize) const -> glm::vec2;
     auto nearestHigherFrame(float _key) const -> std::vector<Frame>::const_iterator;
 
+    // Precompute eval() for parameter @_key at integer zoom levels, as used when
+    // building tiles. Other zoom levels are interpolated between frames.
+    void buildLookup(StyleParamKey _key);
+
     static void eval(const Stops& _stops, StyleParamKey _key, float _zoom, StyleParam::Value& _result);
 };
 
@@ -6,11 +6,16 @@
 #include "log.h"
 #include "platform.h"
 #include "scene/filters.h"
+#include "scene/nativeFunction.h"
 #include "scene/scene.h"
 #include "util/mapProjection.h"
 #include "util/builders.h"
+#include "util/hash.h"
 #include "util/yamlUtil.h"
 
+#include <cstring>
+#include <set>
+
 namespace Tangram {
 
 static const std::vector<std::string> s_geometryStrings = {
@@ -98,14 +103,25 @@ void StyleContext::initFunctions(const Scene& _scene) {
     m_sceneId = _scene.id;
 
     setSceneGlobals(_scene.config()["global"]);
-    setFunctions(_scene.functions());
+    setFunctions(_scene.functions(), _scene.functionBytecode());
 }
 
 bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
+    return setFunctions(_functions, {});
+}
+
+bool StyleContext::setFunctions(const std::vector<std::string>& _functions,
+                                const std::vector<std::vector<uint8_t>>& _bytecode) {
     uint32_t id = 0;
     bool success = true;
+    m_nativeFunctions.clear();
+    m_functionCaches.clear();
     for (auto& function : _functions) {
-        success &= m_jsContext->setFunction(id++, function);
+        bool compiled = (id < _bytecode.size() && m_jsContext->setFunctionBytecode(id, _bytecode[id])) ||
+                        m_jsContext->setFunction(id, function);
+        if (compiled) { initFunction(id, function); }
+        success &= compiled;
+        id++;
     }
 
     m_functionCount = id;
@@ -113,11 +129,378 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
     return success;
 }
 
+size_t StyleContext::compileFunctions(const std::vector<std::string>& _functions,
+                                      std::vector<std::vector<uint8_t>>& _bytecode) {
+    JSContext jsContext;
+    size_t size = 0;
+
+    _bytecode.clear();
+    _bytecode.resize(_functions.size());
+
+    for (uint32_t id = 0; id < _functions.size(); id++) {
+        if (!jsContext.setFunction(id, _functions[id]) ||
+            !jsContext.getFunctionBytecode(id, _bytecode[id])) {
+            _bytecode[id].clear();
+        }
+        size += _bytecode[id].size();
+    }
+    return size;
+}
+
+size_t StyleContext::jsHeapSize() const {
+    return m_jsContext->heapSize();
+}
+
 bool StyleContext::addFunction(const std::string& _function) {
-    bool success = m_jsContext->setFunction(m_functionCount++, _function);
+    FunctionID id = m_functionCount++;
+    bool success = m_jsContext->setFunction(id, _function);
+    if (success) { initFunction(id, _function); }
     return success;
 }
 
+// Maximum number of cached results per function and tile
+static const size_t maxCacheEntries = 4096;
+
+struct JSToken {
+    enum Type { identifier, punctuator, string, number } type;
+    std::string text;
+};
+
+// Split JS source into tokens. Returns false for sources that are not tokenized
+// reliably by this simple scanner, i.e. with template or regular expression literals.
+static bool tokenizeFunction(const std::string& _source, std::vector<JSToken>& _tokens) {
+
+    // Longest punctuators first
+    static const char* punctuators[] = {
+        ">>>=", "===", "!==", "**=", "<<=", ">>=", ">>>", "...", "=>", "==", "!=", "<=", ">=",
+        "&&", "||", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "**", "<<", ">>"
+    };
+
+    auto isIdentifierPart = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' ||
+            static_cast<unsigned char>(c) >= 0x80;
+    };
+
+    size_t i = 0, n = _source.size();
+    while (i < n) {
+        char c = _source[i];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+        } else if (c == '/' && i + 1 < n && _source[i + 1] == '/') {
+            while (i < n && _source[i] != '\n') { i++; }
+        } else if (c == '/' && i + 1 < n && _source[i + 1] == '*') {
+            size_t end = _source.find("*/", i + 2);
+            if (end == std::string::npos) { return false; }
+            i = end + 2;
+        } else if (c == '`') {
+            return false;
+        } else if (c == '/' && (_tokens.empty() ||
+                                (_tokens.back().type == JSToken::punctuator &&
+                                 _tokens.back().text != ")" && _tokens.back().text != "]") ||
+                                _tokens.back().text == "return")) {
+            // Regular expression literal
+            return false;
+        } else if (c == '\'' || c == '"') {
+            std::string text;
+            for (i++; i < n && _source[i] != c; i++) {
+                if (_source[i] == '\\') {
+                    if (++i == n) { return false; }
+                    // Escapes other than quotes are kept, only used for property names
+                    if (_source[i] != '\'' && _source[i] != '"' && _source[i] != '\\') {
+                        text += '\\';
+                    }
+                }
+                text += _source[i];
+            }
+            if (i == n) { return false; }
+            i++;
+            _tokens.push_back({ JSToken::string, std::move(text) });
+        } else if (isIdentifierPart(c)) {
+            size_t start = i;
+            while (i < n && (isIdentifierPart(_source[i]) || (_source[i] == '.' &&
+                       std::isdigit(static_cast<unsigned char>(_source[start]))))) {
+                i++;
+            }
+            bool number = std::isdigit(static_cast<unsigned char>(c));
+            _tokens.push_back({ number ? JSToken::number : JSToken::identifier,
+                                _source.substr(start, i - start) });
+        } else {
+            std::string text(1, c);
+            for (auto* punctuator : punctuators) {
+                if (_source.compare(i, strlen(punctuator), punctuator) == 0) {
+                    text = punctuator;
+                    break;
+                }
+            }
+            i += text.size();
+            _tokens.push_back({ JSToken::punctuator, std::move(text) });
+        }
+    }
+    return true;
+}
+
+// Collect the feature properties and keywords read by a JS function. Returns false when the
+// result may depend on anything else or the function may have side effects: when 'feature'
+// is used other than for reading a named property, when it calls global functions which
+// might read the feature, uses non-deterministic builtins or assigns to non-local variables.
+static bool analyzeFunction(const std::string& _source, std::vector<std::string>& _keys, bool& _geometry) {
+
+    std::vector<JSToken> tokens;
+    if (!tokenizeFunction(_source, tokens)) { return false; }
+
+    static const std::set<std::string> impureIdentifiers = {
+        "this", "arguments", "eval", "Function", "Date", "random", "setTimeout", "setInterval",
+        "Object", "Reflect", "Proxy", "with", "delete", "new", "import", "require"
+    };
+    static const std::set<std::string> assignments = {
+        "=", "+=", "-=", "*=", "/=", "%=", "**=", "<<=", ">>=", ">>>=", "&=", "|=", "^=", "++", "--"
+    };
+    // Global functions that cannot read the current feature
+    static const std::set<std::string> pureGlobals = {
+        "Math", "String", "Number", "Boolean", "parseInt", "parseFloat", "isNaN", "isFinite"
+    };
+    static const std::set<std::string> controlKeywords = {
+        "if", "for", "while", "switch", "catch", "return", "typeof", "function"
+    };
+
+    std::set<std::string> locals;
+    std::set<std::string> keys;
+    bool usesGlobal = false;
+    bool hasCalls = false;
+
+    auto is = [&](size_t i, const char* text) {
+        return i < tokens.size() && tokens[i].type == JSToken::punctuator && tokens[i].text == text;
+    };
+    auto isWord = [&](size_t i, const char* text) {
+        return i < tokens.size() && tokens[i].type == JSToken::identifier && tokens[i].text == text;
+    };
+    auto isMember = [&](size_t i) { return i > 0 && is(i - 1, "."); };
+
+    // First pass: declared local variables and function parameters
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (isWord(i, "var") || isWord(i, "let") || isWord(i, "const")) {
+            // Declared names at the top level of the declaration
+            int depth = 0;
+            bool expectName = true;
+            for (size_t j = i + 1; j < tokens.size(); j++) {
+                const auto& t = tokens[j];
+                if (t.type == JSToken::punctuator) {
+                    if (t.text == "(" || t.text == "[" || t.text == "{") { depth++; }
+                    else if (t.text == ")" || t.text == "]" || t.text == "}") {
+                        if (--depth < 0) { break; }
+                    }
+                    else if (depth == 0 && t.text == ",") { expectName = true; continue; }
+                    else if (depth == 0 && t.text == ";") { break; }
+                } else if (expectName && t.type == JSToken::identifier) {
+                    locals.insert(t.text);
+                }
+                expectName = false;
+            }
+        } else if (isWord(i, "function")) {
+            size_t j = i + 1;
+            if (j < tokens.size() && tokens[j].type == JSToken::identifier) { j++; }
+            if (!is(j, "(")) { continue; }
+            for (j++; j < tokens.size() && !is(j, ")"); j++) {
+                if (tokens[j].type == JSToken::identifier) { locals.insert(tokens[j].text); }
+            }
+        } else if (is(i, "=>") && i > 0) {
+            if (tokens[i - 1].type == JSToken::identifier) {
+                locals.insert(tokens[i - 1].text);
+            } else if (is(i - 1, ")")) {
+                for (size_t j = i - 1; j > 0 && !is(j, "("); j--) {
+                    if (tokens[j].type == JSToken::identifier) { locals.insert(tokens[j].text); }
+                }
+            }
+        }
+    }
+
+    if (locals.count("feature") || locals.count("global")) { return false; }
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const auto& token = tokens[i];
+
+        if (token.type == JSToken::identifier && !isMember(i)) {
+
+            if (impureIdentifiers.count(token.text)) { return false; }
+
+            if (token.text == "feature") {
+                if (is(i + 1, ".") && i + 2 < tokens.size() &&
+                    tokens[i + 2].type == JSToken::identifier) {
+                    keys.insert(tokens[i + 2].text);
+                    i += 2;
+                } else if (is(i + 1, "[") && i + 3 < tokens.size() &&
+                           tokens[i + 2].type == JSToken::string && is(i + 3, "]") &&
+                           tokens[i + 2].text.find('\\') == std::string::npos) {
+                    keys.insert(tokens[i + 2].text);
+                    i += 3;
+                } else {
+                    return false;
+                }
+                // Assignments to feature properties are left to the JSContext
+                if (i + 1 < tokens.size() && assignments.count(tokens[i + 1].text)) { return false; }
+                continue;
+            }
+
+            if (token.text == "$geometry") { _geometry = true; }
+            if (token.text == "global") { usesGlobal = true; }
+
+        } else if (token.type == JSToken::identifier && token.text == "random") {
+            return false;
+        }
+
+        if (token.type != JSToken::punctuator) { continue; }
+
+        if (token.text == "(" && i > 0 &&
+            (tokens[i - 1].type == JSToken::identifier || is(i - 1, ")") || is(i - 1, "]"))) {
+
+            // Find the root of the callee, e.g. 'Math' for 'Math.max('
+            size_t root = i - 1;
+            while (root >= 2 && tokens[root].type == JSToken::identifier && is(root - 1, ".")) {
+                root -= 2;
+            }
+            const auto& callee = tokens[root];
+
+            if (callee.type == JSToken::string || callee.type == JSToken::number) {
+                // Method of a literal
+            } else if (callee.type != JSToken::identifier) {
+                // Method of an expression result
+                hasCalls = true;
+            } else if (root == i - 1 && controlKeywords.count(callee.text)) {
+                // Not a call
+            } else if (pureGlobals.count(callee.text) || (callee.text == "feature" && root < i - 1)) {
+                // Pure builtin or method of a property value
+            } else if (locals.count(callee.text)) {
+                // Locals could hold functions from the scene globals
+                hasCalls = true;
+            } else {
+                return false;
+            }
+        }
+
+        if (assignments.count(token.text)) {
+            // Find the root of the assignment target
+            size_t target;
+            bool prefix = (token.text == "++" || token.text == "--") &&
+                !(i > 0 && (tokens[i - 1].type == JSToken::identifier || is(i - 1, ")") || is(i - 1, "]")));
+
+            if (prefix) {
+                target = i + 1;
+            } else {
+                if (i == 0) { return false; }
+                target = i - 1;
+                while (target > 0) {
+                    if (is(target, "]")) {
+                        // Skip to the matching '['
+                        int depth = 0;
+                        for (; target > 0; target--) {
+                            if (is(target, "]")) { depth++; }
+                            if (is(target, "[") && --depth == 0) { break; }
+                        }
+                        if (target == 0) { return false; }
+                        target--;
+                    } else if (tokens[target].type == JSToken::identifier && target >= 2 &&
+                               is(target - 1, ".")) {
+                        target -= 2;
+                    } else {
+                        break;
+                    }
+                }
+            }
+            if (target >= tokens.size() || tokens[target].type != JSToken::identifier ||
+                !locals.count(tokens[target].text)) {
+                return false;
+            }
+        }
+    }
+
+    // Functions from the scene globals may read the feature
+    if (usesGlobal && hasCalls) { return false; }
+
+    _keys.assign(keys.begin(), keys.end());
+    return true;
+}
+
+void StyleContext::initFunction(FunctionID _id, const std::string& _function) {
+    if (m_nativeFunctions.size() <= _id) {
+        m_nativeFunctions.resize(_id + 1);
+        m_functionCaches.resize(_id + 1);
+    }
+    m_nativeFunctions[_id].reset();
+    m_functionCaches[_id].reset();
+
+    auto native = std::make_unique<NativeFunction>();
+    if (native->compile(_function)) {
+        m_nativeFunctions[_id] = std::move(native);
+        return;
+    }
+
+    auto cache = std::make_unique<FunctionCache>();
+    if (analyzeFunction(_function, cache->keys, cache->geometry)) {
+        m_functionCaches[_id] = std::move(cache);
+    }
+}
+
+void StyleContext::clearFunctionCache() {
+    for (auto& cache : m_functionCaches) {
+        if (cache) {
+            cache->entries.clear();
+            cache->size = 0;
+        }
+    }
+}
+
+int StyleContext::functionCacheSize(FunctionID _id) const {
+    if (_id >= m_functionCaches.size() || !m_functionCaches[_id]) { return -1; }
+    return int(m_functionCaches[_id]->size);
+}
+
+StyleContext::FunctionCache::Entry* StyleContext::getCacheEntry(FunctionID _id, bool _filter,
+                                                               StyleParamKey _key, bool& _found) {
+    _found = false;
+    if (_id >= m_functionCaches.size() || !m_functionCaches[_id] || !m_feature) { return nullptr; }
+
+    auto& cache = *m_functionCaches[_id];
+    int geometry = cache.geometry ? m_feature->geometryType : -1;
+
+    size_t hash = 0;
+    hash_combine(hash, geometry);
+    for (const auto& key : cache.keys) {
+        const auto& value = m_feature->props.get(key);
+        if (value.is<std::string>()) {
+            hash_combine(hash, value.get<std::string>());
+        } else if (value.is<double>()) {
+            hash_combine(hash, value.get<double>());
+        } else {
+            hash_combine(hash, 0);
+        }
+    }
+
+    auto& entries = cache.entries[hash];
+    for (auto& entry : entries) {
+        if (entry.filter != _filter || entry.key != _key || entry.geometry != geometry) { continue; }
+
+        bool equal = true;
+        for (size_t i = 0; i < cache.keys.size() && equal; i++) {
+            equal = entry.values[i] == m_feature->props.get(cache.keys[i]);
+        }
+        if (equal) {
+            _found = true;
+            return &entry;
+        }
+    }
+
+    if (cache.size >= maxCacheEntries) { return nullptr; }
+    cache.size++;
+
+    entries.push_back({ {}, geometry, _filter, _key, false, {} });
+    auto& entry = entries.back();
+    for (const auto& key : cache.keys) {
+        entry.values.push_back(m_feature->props.get(key));
+    }
+    return &entry;
+}
+
 void StyleContext::setFeature(const Feature& _feature) {
 
     m_feature = &_feature;
@@ -132,6 +515,8 @@ void StyleContext::setFeature(const Feature& _feature) {
 
 void StyleContext::setZoom(double zoom) {
     if (m_zoom != zoom) {
+        // Cached results may depend on $zoom and $meters_per_pixel
+        clearFunctionCache();
         setKeyword(FilterKeyword::zoom, zoom);
         m_zoom = zoom;
         // When new zoom is set, meters_per_pixel must be updated too.
@@ -171,17 +556,178 @@ double StyleContext::getPixelAreaScale() {
 }
 
 void StyleContext::clear() {
+    m_feature = nullptr;
     m_jsContext->setCurrentFeature(nullptr);
 }
 
 bool StyleContext::evalFilter(FunctionID _id) {
+    if (_id < m_nativeFunctions.size() && m_nativeFunctions[_id] && m_feature) {
+        bool result;
+        if (m_nativeFunctions[_id]->eval(*m_feature, *this, result)) {
+            return result;
+        }
+    }
+
+    bool found;
+    auto* entry = getCacheEntry(_id, true, StyleParamKey::NUM_ELEMENTS, found);
+    if (found) { return entry->result; }
+
     bool result = m_jsContext->evaluateBooleanFunction(_id);
+
+    if (entry) { entry->result = result; }
     return result;
 }
 
+static void parseStyleString(StyleParamKey _key, std::string _value, StyleParam::Value& _val) {
+    switch (_key) {
+        case StyleParamKey::outline_style:
+        case StyleParamKey::repeat_group:
+        case StyleParamKey::sprite:
+        case StyleParamKey::sprite_default:
+        case StyleParamKey::style:
+        case StyleParamKey::text_align:
+        case StyleParamKey::text_repeat_group:
+        case StyleParamKey::text_source:
+        case StyleParamKey::text_source_left:
+        case StyleParamKey::text_source_right:
+        case StyleParamKey::text_transform:
+        case StyleParamKey::texture:
+            _val = std::move(_value);
+            break;
+        case StyleParamKey::color:
+        case StyleParamKey::outline_color:
+        case StyleParamKey::text_font_fill:
+        case StyleParamKey::text_font_stroke_color: {
+            Color result;
+            if (StyleParam::parseColor(_value, result)) {
+                _val = result.abgr;
+            } else {
+                LOGW("Invalid color value: %s", _value.c_str());
+            }
+            break;
+        }
+        default:
+            _val = StyleParam::parseString(_key, _value);
+            break;
+    }
+}
+
+static void parseStyleBoolean(StyleParamKey _key, bool _value, StyleParam::Value& _val) {
+    switch (_key) {
+        case StyleParamKey::interactive:
+        case StyleParamKey::text_interactive:
+        case StyleParamKey::visible:
+            _val = _value;
+            break;
+        case StyleParamKey::extrude:
+            _val = _value ? glm::vec2(NAN, NAN) : glm::vec2(0.0f, 0.0f);
+            break;
+        default:
+            break;
+    }
+}
+
+static void parseStyleNumber(StyleParamKey _key, double _number, StyleParam::Value& _val) {
+    if (std::isnan(_number)) {
+        LOGD("duk evaluates JS method to NAN.\n");
+    }
+    switch (_key) {
+        case StyleParamKey::text_source:
+        case StyleParamKey::text_source_left:
+        case StyleParamKey::text_source_right:
+            _val = doubleToString(_number);
+            break;
+        case StyleParamKey::extrude:
+            _val = glm::vec2(0.f, _number);
+            break;
+        case StyleParamKey::placement_spacing: {
+            _val = StyleParam::Width{static_cast<float>(_number), Unit::pixel};
+            break;
+        }
+        case StyleParamKey::width:
+        case StyleParamKey::outline_width: {
+            // TODO more efficient way to return pixels.
+            // atm this only works by return value as string
+            _val = StyleParam::Width{static_cast<float>(_number)};
+            break;
+        }
+        case StyleParamKey::alpha:
+        case StyleParamKey::angle:
+        case StyleParamKey::outline_alpha:
+        case StyleParamKey::priority:
+        case StyleParamKey::text_font_alpha:
+        case StyleParamKey::text_font_stroke_alpha:
+        case StyleParamKey::text_priority:
+        case StyleParamKey::text_font_stroke_width:
+        case StyleParamKey::placement_min_length_ratio: {
+            _val = static_cast<float>(_number);
+            break;
+        }
+        case StyleParamKey::size: {
+            StyleParam::SizeValue vec;
+            vec.x.value = static_cast<float>(_number);
+            _val = vec;
+            break;
+        }
+        case StyleParamKey::order:
+        case StyleParamKey::outline_order:
+        case StyleParamKey::color:
+        case StyleParamKey::outline_color:
+        case StyleParamKey::text_font_fill:
+        case StyleParamKey::text_font_stroke_color: {
+            _val = static_cast<uint32_t>(_number);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Value& _val) {
     _val = none_type{};
 
+    if (_id < m_nativeFunctions.size() && m_nativeFunctions[_id] && m_feature) {
+        NativeFunction::Result result;
+        // Null results are logged by the JSContext path
+        if (m_nativeFunctions[_id]->eval(*m_feature, *this, result) &&
+            result.type != NativeFunction::Result::Type::null) {
+
+            switch (result.type) {
+                case NativeFunction::Result::Type::string:
+                    parseStyleString(_key, std::move(result.string), _val);
+                    break;
+                case NativeFunction::Result::Type::boolean:
+                    parseStyleBoolean(_key, result.boolean, _val);
+                    break;
+                case NativeFunction::Result::Type::number:
+                    parseStyleNumber(_key, result.number, _val);
+                    break;
+                default:
+                    _val = Undefined();
+                    break;
+            }
+            return !_val.is<none_type>();
+        }
+    }
+
+    bool found;
+    auto* entry = getCacheEntry(_id, false, _key, found);
+    if (found) {
+        _val = entry->value;
+        return entry->result;
+    }
+
+    bool result = evalJSStyle(_id, _key, _val);
+
+    if (entry) {
+        entry->value = _val;
+        entry->result = result;
+    }
+    return result;
+}
+
+bool StyleContext::evalJSStyle(FunctionID _id, StyleParamKey _key, StyleParam::Value& _val) {
+
     JSScope jsScope(*m_jsContext);
     auto jsValue = jsScope.getFunctionResult(_id);
     if (!jsValue) {
@@ -189,55 +735,10 @@ bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Val
     }
 
     if (jsValue.isString()) {
-        std::string value = jsValue.toString();
-
-        switch (_key) {
-            case StyleParamKey::outline_style:
-            case StyleParamKey::repeat_group:
-            case StyleParamKey::sprite:
-            case StyleParamKey::sprite_default:
-            case StyleParamKey::style:
-            case StyleParamKey::text_align:
-            case StyleParamKey::text_repeat_group:
-            case StyleParamKey::text_source:
-            case StyleParamKey::text_source_left:
-            case StyleParamKey::text_source_right:
-            case StyleParamKey::text_transform:
-            case StyleParamKey::texture:
-                _val = value;
-                break;
-            case StyleParamKey::color:
-            case StyleParamKey::outline_color:
-            case StyleParamKey::text_font_fill:
-            case StyleParamKey::text_font_stroke_color: {
-                Color result;
-                if (StyleParam::parseColor(value, result)) {
-                    _val = result.abgr;
-                } else {
-                    LOGW("Invalid color value: %s", value.c_str());
-                }
-                break;
-            }
-            default:
-                _val = StyleParam::parseString(_key, value);
-                break;
-        }
+        parseStyleString(_key, jsValue.toString(), _val);
 
     } else if (jsValue.isBoolean()) {
-        bool value = jsValue.toBool();
-
-        switch (_key) {
-            case StyleParamKey::interactive:
-            case StyleParamKey::text_interactive:
-            case StyleParamKey::visible:
-                _val = value;
-                break;
-            case StyleParamKey::extrude:
-                _val = value ? glm::vec2(NAN, NAN) : glm::vec2(0.0f, 0.0f);
-                break;
-            default:
-                break;
-        }
+        parseStyleBoolean(_key, jsValue.toBool(), _val);
 
     } else if (jsValue.isArray()) {
         auto len = jsValue.getLength();
@@ -277,60 +778,8 @@ bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Val
                 break;
         }
     } else if (jsValue.isNumber()) {
-        double number = jsValue.toDouble();
-        if (std::isnan(number)) {
-            LOGD("duk evaluates JS method to NAN.\n");
-        }
-        switch (_key) {
-            case StyleParamKey::text_source:
-            case StyleParamKey::text_source_left:
-            case StyleParamKey::text_source_right:
-                _val = doubleToString(number);
-                break;
-            case StyleParamKey::extrude:
-                _val = glm::vec2(0.f, number);
-                break;
-            case StyleParamKey::placement_spacing: {
-                _val = StyleParam::Width{static_cast<float>(number), Unit::pixel};
-                break;
-            }
-            case StyleParamKey::width:
-            case StyleParamKey::outline_width: {
-                // TODO more efficient way to return pixels.
-                // atm this only works by return value as string
-                _val = StyleParam::Width{static_cast<float>(number)};
-                break;
-            }
-            case StyleParamKey::alpha:
-            case StyleParamKey::angle:
-            case StyleParamKey::outline_alpha:
-            case StyleParamKey::priority:
-            case StyleParamKey::text_font_alpha:
-            case StyleParamKey::text_font_stroke_alpha:
-            case StyleParamKey::text_priority:
-            case StyleParamKey::text_font_stroke_width:
-            case StyleParamKey::placement_min_length_ratio: {
-                _val = static_cast<float>(number);
-                break;
-            }
-            case StyleParamKey::size: {
-                StyleParam::SizeValue vec;
-                vec.x.value = static_cast<float>(number);
-                _val = vec;
-                break;
-            }
-            case StyleParamKey::order:
-            case StyleParamKey::outline_order:
-            case StyleParamKey::color:
-            case StyleParamKey::outline_color:
-            case StyleParamKey::text_font_fill:
-            case StyleParamKey::text_font_stroke_color: {
-                _val = static_cast<uint32_t>(number);
-                break;
-            }
-            default:
-                break;
-        }
+        parseStyleNumber(_key, jsValue.toDouble(), _val);
+
     } else if (jsValue.isUndefined()) {
         // Explicitly set value as 'undefined'. This is important for some styling rules.
         _val = Undefined();
@@ -6,6 +6,8 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace YAML {
     class Node;
@@ -13,6 +15,7 @@ namespace YAML {
 
 namespace Tangram {
 
+class NativeFunction;
 class Scene;
 struct Feature;
 struct StyleParam;
@@ -60,7 +63,27 @@ public:
     /// Unset the current Feature.
     void clear();
 
+    /// Drop cached JS function results, called for each tile.
+    void clearFunctionCache();
+
+    /// Number of cached results of function @id, -1 when not cacheable. For testing.
+    int functionCacheSize(FunctionID id) const;
+
     bool setFunctions(const std::vector<std::string>& functions);
+
+    /// Set functions from @bytecode produced by compileFunctions(), functions without
+    /// bytecode are compiled from source.
+    bool setFunctions(const std::vector<std::string>& functions,
+                      const std::vector<std::vector<uint8_t>>& bytecode);
+
+    /// Compile @functions to @bytecode that can be loaded by other StyleContexts.
+    /// Returns the total size of the bytecode, zero when the JSContext does not
+    /// support loading compiled functions.
+    static size_t compileFunctions(const std::vector<std::string>& functions,
+                                   std::vector<std::vector<uint8_t>>& bytecode);
+
+    /// Bytes allocated by the JSContext
+    size_t jsHeapSize() const;
     bool addFunction(const std::string& function);
     void setSceneGlobals(const YAML::Node& sceneGlobals);
 
@@ -68,6 +91,41 @@ private:
 
     void setKeyword(FilterKeyword keyword, Value value);
 
+    // Results of a JS function for features with the same values of the properties
+    // and keywords read by the function. Only set for functions that do not read
+    // any other state and have no side effects, see analyzeFunction().
+    struct FunctionCache {
+        struct Entry {
+            std::vector<Value> values;
+            int geometry;
+            // Filter result or style value for 'key'
+            bool filter;
+            StyleParamKey key;
+            bool result;
+            StyleParam::Value value;
+        };
+
+        // Feature properties read by the function
+        std::vector<std::string> keys;
+        // Whether the function reads $geometry. $zoom and $meters_per_pixel
+        // are constant while the cache is valid.
+        bool geometry = false;
+
+        // Entries by hash of their values
+        std::unordered_map<size_t, std::vector<Entry>> entries;
+        size_t size = 0;
+    };
+
+    // Compile a native evaluator or set up result caching for function @id
+    void initFunction(FunctionID id, const std::string& function);
+
+    bool evalJSStyle(FunctionID id, StyleParamKey key, StyleParam::Value& value);
+
+    // Returns the cache entry of function @id for the current feature, @found tells
+    // whether it holds a result or was just added for the caller to fill in. Returns
+    // null when the function is not cacheable or the cache is full.
+    FunctionCache::Entry* getCacheEntry(FunctionID id, bool filter, StyleParamKey key, bool& found);
+
     std::array<Value, 4> m_keywordValues;
 
     // Cache zoom separately from keywords for easier access.
@@ -83,6 +141,13 @@ private:
     const Feature* m_feature = nullptr;
 
     std::unique_ptr<JSContext> m_jsContext;
+
+    // Native evaluators of simple functions, indexed by FunctionID.
+    // Functions without one are evaluated by the JSContext.
+    std::vector<std::unique_ptr<NativeFunction>> m_nativeFunctions;
+
+    // Result caches indexed by FunctionID, null for functions that are not cacheable
+    std::vector<std::unique_ptr<FunctionCache>> m_functionCaches;
 };
 
 }
@@ -47,6 +47,8 @@ public:
     auto textures() const { return m_textures; }
     const auto& defaultTexture() const { return m_defaultTexture; }
 
+    const Texture* texture() const override { return m_defaultTexture.get(); }
+
     auto& mesh() const { return m_mesh; }
     virtual size_t dynamicMeshSize() const override { return m_mesh->bufferSize(); }
 
@@ -11,6 +11,7 @@
 #include "util/builders.h"
 #include "util/color.h"
 #include "util/extrude.h"
+#include "util/simplify.h"
 
 #include "glm/vec2.hpp"
 #include "glm/vec3.hpp"
@@ -104,13 +105,20 @@ public:
     void setup(const Tile& _tile) override {
         m_tileUnitsPerMeter = _tile.getInverseScale();
         m_zoom = _tile.getID().z;
+        m_simplifier.tolerance = Simplifier::tileTolerance(m_style.simplifyTolerance(),
+                                                           _tile.getID(), m_style.pixelScale());
         m_meshData.clear();
+        m_extrusions.clear();
+        m_sharedWalls.clear();
     }
 
     void setup(const Marker& _marker, int zoom) override {
         m_zoom = zoom;
         m_tileUnitsPerMeter = 1.f / _marker.extent();
+        m_simplifier.tolerance = 0.f;
         m_meshData.clear();
+        m_extrusions.clear();
+        m_sharedWalls.clear();
     }
 
     bool addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
@@ -127,10 +135,27 @@ public:
 
 private:
 
+    // Extruded polygon whose walls are built once all polygons of the tile are known
+    struct Extrusion {
+        Polygon polygon;
+        Parameters params;
+        uint32_t id;
+    };
+
+    template <class HiddenFn>
+    void buildWalls(const Polygon& _polygon, const Parameters& _params, HiddenFn&& _isHidden);
+
+    void addBuilderMesh();
+
     const PolygonStyle& m_style;
 
     PolygonBuilder m_builder;
 
+    std::vector<Extrusion> m_extrusions;
+    SharedWalls m_sharedWalls;
+
+    Simplifier m_simplifier;
+
     MeshData<V> m_meshData;
 
     float m_tileUnitsPerMeter = 0;
@@ -140,13 +165,25 @@ private:
 
 template <class V>
 std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
+
+    for (auto& extrusion : m_extrusions) {
+        buildWalls(extrusion.polygon, extrusion.params,
+                   [&](const glm::vec2& a, const glm::vec2& b) {
+                       return m_sharedWalls.isHidden(extrusion.id, a, b);
+                   });
+    }
+    m_extrusions.clear();
+    m_sharedWalls.clear();
+
     if (m_meshData.vertices.empty()) { return nullptr; }
 
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
                                                       m_style.drawMode());
-    mesh->compile(m_meshData);
+    mesh->compile(std::move(m_meshData));
     m_meshData.clear();
 
+    if (m_style.batchTiles()) { mesh->retainData(position_scale); }
+
     return std::move(mesh);
 }
 
@@ -176,32 +213,58 @@ auto PolygonStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties&
 }
 
 template <class V>
-bool PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) {
+void PolygonStyleBuilder<V>::addBuilderMesh() {
 
-    auto p = parseRule(_rule, _props);
+    m_meshData.indices.insert(m_meshData.indices.end(),
+                              m_builder.indices.begin(),
+                              m_builder.indices.end());
+
+    m_meshData.offsets.emplace_back(m_builder.indices.size(),
+                                    m_builder.numVertices);
+    m_builder.clear();
+}
+
+template <class V>
+template <class HiddenFn>
+void PolygonStyleBuilder<V>::buildWalls(const Polygon& _polygon, const Parameters& p,
+                                        HiddenFn&& _isHidden) {
 
     m_builder.keepTileEdges = p.keepTileEdges;
 
-    m_builder.addVertex = [this, p](const glm::vec3& coord,
-                                 const glm::vec3& normal,
-                                 const glm::vec2& uv) {
-        m_meshData.vertices.push_back({ coord, p.order, normal, uv, p.color, p.selectionColor });
-    };
+    Builders::buildPolygonExtrusion(_polygon, p.minHeight, p.height, m_builder,
+        [this, &p](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+            m_meshData.vertices.push_back({ coord, p.order, normal, uv, p.color, p.selectionColor });
+        },
+        _isHidden);
+
+    addBuilderMesh();
+}
+
+template <class V>
+bool PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) {
+
+    auto p = parseRule(_rule, _props);
+
+    const auto& polygon = m_simplifier.simplify(_polygon);
 
     if (p.minHeight != p.height) {
-        Builders::buildPolygonExtrusion(_polygon, p.minHeight,
-                                        p.height, m_builder);
+        if (m_style.cullSharedWalls()) {
+            // Walls are built in build(), when all adjacent polygons are known
+            uint32_t id = m_sharedWalls.add(polygon, p.minHeight, p.height);
+            m_extrusions.push_back({ polygon, p, id });
+        } else {
+            buildWalls(polygon, p, [](const glm::vec2&, const glm::vec2&) { return false; });
+        }
     }
 
-    Builders::buildPolygon(_polygon, p.height, m_builder);
+    m_builder.keepTileEdges = p.keepTileEdges;
 
-    m_meshData.indices.insert(m_meshData.indices.end(),
-                              m_builder.indices.begin(),
-                              m_builder.indices.end());
+    Builders::buildPolygon(polygon, p.height, m_builder,
+        [this, &p](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+            m_meshData.vertices.push_back({ coord, p.order, normal, uv, p.color, p.selectionColor });
+        });
 
-    m_meshData.offsets.emplace_back(m_builder.indices.size(),
-                                    m_builder.numVertices);
-    m_builder.clear();
+    addBuilderMesh();
 
     return true;
 }
@@ -18,6 +18,14 @@ public:
     virtual std::unique_ptr<StyleBuilder> createBuilder() const override;
     virtual ~PolygonStyle() {}
 
+    // Leave out walls of extruded polygons that are covered by adjacent polygons
+    void setCullSharedWalls(bool _cull) { m_cullSharedWalls = _cull; }
+    bool cullSharedWalls() const { return m_cullSharedWalls; }
+
+protected:
+
+    bool m_cullSharedWalls = false;
+
 };
 
 }
@@ -17,6 +17,7 @@
 #include "util/extrude.h"
 #include "util/floatFormatter.h"
 #include "util/mapProjection.h"
+#include "util/simplify.h"
 
 #include "glm/vec3.hpp"
 #include "glm/gtc/type_precision.hpp"
@@ -207,6 +208,8 @@ private:
     const PolylineStyle& m_style;
     PolyLineBuilder m_builder;
 
+    Simplifier m_simplifier;
+
     std::vector<MeshData<V>> m_meshData;
 
     float m_tileUnitsPerMeter = 0;
@@ -226,6 +229,9 @@ void PolylineStyleBuilder<V>::setup(const Tile& tile) {
     m_tileUnitsPerMeter = tile.getInverseScale();
     m_tileUnitsPerPixel = 1.f / MapProjection::tileSize();
 
+    m_simplifier.tolerance = Simplifier::tileTolerance(m_style.simplifyTolerance(), id,
+                                                       m_style.pixelScale());
+
     // When a tile is overzoomed, we are actually styling the area of its
     // 'source' tile, which will have a larger effective pixel size at the
     // 'style' zoom level. This scaling is performed in the vertex shader to
@@ -238,6 +244,7 @@ void PolylineStyleBuilder<V>::setup(const Marker& marker, int zoom) {
     m_zoom = zoom;
     m_overzoom2 = 1.f;
     m_tileUnitsPerMeter = 1.f / marker.extent();
+    m_simplifier.tolerance = 0.f;
     float metersPerTile = MapProjection::metersPerTileAtZoom(zoom);
 
     // In general, a Marker won't cover the same area as a tile, so the effective
@@ -262,13 +269,16 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
     // Swap draw order to draw outline first when not using depth testing
     if (painterMode) { std::swap(m_meshData[0], m_meshData[1]); }
 
-    mesh->compile(m_meshData);
+    mesh->compile(std::move(m_meshData));
 
     // Swapping back since fill mesh may have more vertices than outline
     if (painterMode) { std::swap(m_meshData[0], m_meshData[1]); }
 
     m_meshData[0].clear();
     m_meshData[1].clear();
+
+    if (m_style.batchTiles()) { mesh->retainData(position_scale); }
+
     return std::move(mesh);
 }
 
@@ -426,13 +436,13 @@ bool PolylineStyleBuilder<V>::addFeature(const Feature& _feat, const DrawRule& _
         params.keepTileEdges = true;
 
         for (auto& line : _feat.lines) {
-            addMesh(line, params);
+            addMesh(m_simplifier.simplify(line), params);
         }
     } else {
         params.closedPolygon = true;
 
         for (auto& polygon : _feat.polygons) {
-            for (const auto& line : polygon) {
+            for (const auto& line : m_simplifier.simplify(polygon)) {
                 addMesh(line, params);
             }
         }
@@ -446,12 +456,12 @@ void PolylineStyleBuilder<V>::buildLine(const Line& _line, const typename Parame
                                         MeshData<V>& _mesh, GLuint selection) {
 
     float zoom = m_overzoom2;
-    m_builder.addVertex = [&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
+    auto addVertex = [&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
         _mesh.vertices.push_back({{ coord.x,coord.y }, normal, { uv.x, uv.y * zoom },
                                   _att.width, _att.height, _att.color, selection});
     };
 
-    Builders::buildPolyLine(_line, m_builder);
+    Builders::buildPolyLine(_line, m_builder, addVertex);
 
     _mesh.indices.insert(_mesh.indices.end(),
                          m_builder.indices.begin(),
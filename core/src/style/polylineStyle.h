@@ -21,6 +21,8 @@ public:
     void setDashArray(std::vector<float> _dashArray) { m_dashArray = _dashArray; }
     void setTexture(std::shared_ptr<Texture>& _texture) { m_texture = _texture; }
 
+    const Texture* texture() const override { return m_texture.get(); }
+
     void setDashBackgroundColor(const glm::vec4 _dashBackgroundColor);
 
 private:
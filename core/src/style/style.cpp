@@ -17,6 +17,8 @@
 
 #include "rasters_glsl.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 Style::Style(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection) :
@@ -383,18 +385,29 @@ bool Style::draw(RenderState& rs, const View& _view,
     // Skip when no mesh is to be rendered.
     // This also compiles shaders when they are first used.
     if (tileIt == std::end(_tiles) && markerIt == std::end(_markers)) {
+        m_tileBatches.clear();
         return false;
     }
 
+    // Drop the batches that were not drawn in the last frame
+    for (auto it = m_tileBatches.begin(); it != m_tileBatches.end();) {
+        if (!it->second.used) {
+            it = m_tileBatches.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+    m_tileBatchMerges = 0;
+
     onBeginDrawFrame(rs, _view);
 
     if (m_blend == Blending::translucent) {
         rs.colorMask(false, false, false, false);
     }
 
-    for (const auto& tile : _tiles) {
-        meshDrawn |= draw(rs, *tile);
-    }
+    meshDrawn |= drawTiles(rs, _tiles);
+
     for (const auto& marker : _markers) {
         meshDrawn |= draw(rs, *marker);
     }
@@ -409,7 +422,7 @@ bool Style::draw(RenderState& rs, const View& _view,
             GL::stencilFunc(GL_EQUAL, GL_ZERO, 0xFF);
             GL::stencilOp(GL_KEEP, GL_KEEP, GL_INCR);
 
-            for (const auto &tile : _tiles) { draw(rs, *tile); }
+            drawTiles(rs, _tiles);
             for (const auto &marker : _markers) { draw(rs, *marker); }
 
             GL::disable(GL_STENCIL_TEST);
@@ -423,6 +436,125 @@ bool Style::draw(RenderState& rs, const View& _view,
 }
 
 
+bool Style::drawTiles(RenderState& rs, const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    bool meshDrawn = false;
+
+    if (!m_batchTiles || hasRasters()) {
+        for (const auto& tile : _tiles) {
+            meshDrawn |= draw(rs, *tile);
+        }
+        return meshDrawn;
+    }
+
+    // Group the tiles in blocks of 2x2 tiles, in the order of their first tile
+    std::map<TileBatchKey, std::vector<std::shared_ptr<Tile>>> blocks;
+    std::vector<decltype(blocks)::iterator> order;
+
+    for (const auto& tile : _tiles) {
+        if (!tile->getMesh(*this)) { continue; }
+
+        const auto& id = tile->getID();
+        TileBatchKey key{ tile->sourceID(), id.z, id.s, tile->isProxy(), id.x >> 1, id.y >> 1 };
+
+        auto block = blocks.emplace(key, std::vector<std::shared_ptr<Tile>>{});
+        if (block.second) { order.push_back(block.first); }
+        block.first->second.push_back(tile);
+    }
+
+    for (auto& block : order) {
+        auto& tiles = block->second;
+
+        if (tiles.size() > 1) {
+            // Keep the order of the merged meshes independent of the tile order
+            std::sort(tiles.begin(), tiles.end(),
+                      [](const auto& a, const auto& b) { return a->getID() < b->getID(); });
+
+            if (drawTileBatch(rs, block->first, tiles)) {
+                meshDrawn = true;
+                continue;
+            }
+        }
+        for (const auto& tile : tiles) {
+            meshDrawn |= draw(rs, *tile);
+        }
+    }
+
+    return meshDrawn;
+}
+
+bool Style::drawTileBatch(RenderState& rs, const TileBatchKey& _key,
+                          const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    // The merged mesh is positioned at the south-west tile of the block
+    const auto& firstID = _tiles[0]->getID();
+    int32_t anchorX = firstID.x & ~1;
+    int32_t anchorY = firstID.y | 1;
+    float scale = _tiles[0]->getScale();
+
+    glm::vec2 translation;
+    glm::dvec2 origin;
+    std::vector<StyledMesh::MergeItem> items;
+
+    for (size_t i = 0; i < _tiles.size(); i++) {
+        auto& tile = *_tiles[i];
+        glm::ivec2 offset{ tile.getID().x - anchorX, anchorY - tile.getID().y };
+
+        // Tiles of a block may be wrapped to different sides of the view
+        glm::vec2 t = glm::vec2(tile.getModelMatrix()[3]) - glm::vec2(offset) * scale;
+        if (i == 0) {
+            translation = t;
+            origin = tile.getOrigin() - glm::dvec2(offset) * double(scale);
+        } else if (glm::any(glm::greaterThan(glm::abs(t - translation), glm::vec2(scale * 1e-3f)))) {
+            return false;
+        }
+        items.push_back({ tile.getMesh(*this).get(), offset });
+    }
+
+    auto& batch = m_tileBatches[_key];
+    batch.used = true;
+
+    bool sameTiles = batch.tiles.size() == _tiles.size();
+    for (size_t i = 0; sameTiles && i < _tiles.size(); i++) {
+        sameTiles = (batch.tiles[i].lock() == _tiles[i] && batch.meshes[i] == items[i].mesh);
+    }
+
+    if (!sameTiles) {
+        // Draw the tiles one by one until the merge budget of a later frame allows it
+        if (m_tileBatchMerges >= maxTileBatchMerges) { return false; }
+        m_tileBatchMerges++;
+
+        batch.tiles.assign(_tiles.begin(), _tiles.end());
+        batch.meshes.clear();
+        for (auto& item : items) { batch.meshes.push_back(item.mesh); }
+        batch.mesh = items[0].mesh->merge(items);
+    }
+
+    if (!batch.mesh) { return false; }
+
+    glm::mat4 model = _tiles[0]->getModelMatrix();
+    model[3][0] = translation.x;
+    model[3][1] = translation.y;
+
+    m_shaderProgram->setUniformMatrix4f(rs, m_mainUniforms.uModel, model);
+    m_shaderProgram->setUniformf(rs, m_mainUniforms.uProxyDepth, std::get<3>(_key) ? 1.f : 0.f);
+    m_shaderProgram->setUniformf(rs, m_mainUniforms.uTileOrigin,
+                                 origin.x, origin.y, firstID.s, firstID.z);
+
+    if (!batch.mesh->draw(rs, *m_shaderProgram)) {
+        LOGN("Merged mesh of style %s cannot be drawn", m_name.c_str());
+        return false;
+    }
+
+    // Keep only the merged mesh on the GPU, the tile meshes keep their
+    // data and are uploaded again when they are drawn on their own
+    for (auto& tile : _tiles) {
+        tile->getMesh(*this)->releaseResident();
+    }
+
+    return true;
+}
+
 bool Style::draw(RenderState& rs, const Tile& _tile) {
 
     auto& styleMesh = _tile.getMesh(*this);
@@ -520,7 +652,7 @@ void Style::applyDefaultDrawRules(DrawRule& _rule) const {
         for (auto& param : m_defaultDrawRule->parameters) {
             auto key = static_cast<uint8_t>(param.key);
             if (!_rule.active[key]) {
-                _rule.active[key] = true;
+                _rule.activate(key);
                 // NOTE: layername and layer depth are actually immaterial here, since these are
                 // only used during layer draw rules merging. Adding a default string for
                 // debugging purposes.
@@ -6,8 +6,10 @@
 #include "scene/drawRule.h"
 #include "util/fastmap.h"
 
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace Tangram {
@@ -24,6 +26,7 @@ class ShaderProgram;
 class ShaderSource;
 class Style;
 class Tile;
+class Texture;
 class TileSource;
 class VertexLayout;
 class View;
@@ -67,6 +70,27 @@ struct StyledMesh {
     virtual bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) = 0;
     virtual size_t bufferSize() const = 0;
 
+    // Returns false while the mesh data is not uploaded to GPU buffers
+    virtual bool isResident() const { return true; }
+
+    // Upload the mesh data before it is first drawn, returns the number of uploaded bytes
+    virtual size_t makeResident(RenderState& rs) { return 0; }
+
+    // Free the GPU buffers of a mesh that keeps its data, it is uploaded again when drawn
+    virtual void releaseResident() {}
+
+    struct MergeItem {
+        const StyledMesh* mesh;
+        // Offset of the mesh in the merged mesh, in tile units
+        glm::ivec2 offset;
+    };
+
+    // Returns a mesh of the same type with the data of @_meshes, or nullptr when
+    // they cannot be merged
+    virtual std::unique_ptr<StyledMesh> merge(const std::vector<MergeItem>& _meshes) const {
+        return nullptr;
+    }
+
     virtual ~StyledMesh() {}
 };
 
@@ -153,6 +177,9 @@ protected:
     /* Whether the style should generate texture coordinates */
     bool m_texCoordsGeneration = false;
 
+    /* Tolerance in pixels for simplifying lines and polygons before building meshes */
+    float m_simplifyTolerance = 0.f;
+
     bool m_hasColorShaderBlock = false;
 
     RasterType m_rasterType = RasterType::none;
@@ -206,6 +233,34 @@ protected:
     std::vector<LightHandle> m_lights;
     MaterialHandle m_material;
 
+    /* Draw the meshes of neighboring tiles as one merged mesh when possible. The tile
+     * meshes keep a CPU copy of their data for merging. Their GPU buffers are freed
+     * once they are merged, so that only the merged mesh is kept on the GPU. */
+    bool m_batchTiles = false;
+
+    // Source, data zoom, styling zoom, proxy state and index of the 2x2 tile block
+    using TileBatchKey = std::tuple<int32_t, int8_t, int8_t, bool, int32_t, int32_t>;
+
+    struct TileBatch {
+        std::vector<std::weak_ptr<Tile>> tiles;
+        std::vector<const StyledMesh*> meshes;
+        // nullptr when the meshes of the tiles cannot be merged
+        std::unique_ptr<StyledMesh> mesh;
+        bool used = false;
+    };
+
+    std::map<TileBatchKey, TileBatch> m_tileBatches;
+    int m_tileBatchMerges = 0;
+
+    // Maximum number of tile batches that are merged in one frame
+    static constexpr int maxTileBatchMerges = 2;
+
+    bool drawTiles(RenderState& rs, const std::vector<std::shared_ptr<Tile>>& _tiles);
+
+    /* Draws the merged mesh of @_tiles, returns false when the tiles must be drawn one by one */
+    bool drawTileBatch(RenderState& rs, const TileBatchKey& _key,
+                       const std::vector<std::shared_ptr<Tile>>& _tiles);
+
 public:
 
     Style(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection);
@@ -302,6 +357,14 @@ public:
 
     bool genTexCoords() const { return m_texCoordsGeneration; }
 
+    void setSimplifyTolerance(float _pixels) { m_simplifyTolerance = _pixels; }
+
+    float simplifyTolerance() const { return m_simplifyTolerance; }
+
+    void setBatchTiles(bool _batchTiles) { m_batchTiles = _batchTiles; }
+
+    bool batchTiles() const { return m_batchTiles; }
+
     void setID(uint32_t _id) { m_id = _id; }
 
     Material& getMaterial() { return *m_material.material; }
@@ -315,6 +378,9 @@ public:
 
     virtual bool hasRasters() const { return m_rasterType != RasterType::none; }
 
+    /* Texture that is bound for most draws of this style, used to order the draws of a frame */
+    virtual const Texture* texture() const { return nullptr; }
+
     std::vector<StyleUniform>& styleUniforms() { return m_mainUniforms.styleUniforms; }
 
     void setDefaultDrawRule(std::unique_ptr<DrawRuleData>&& _rule);
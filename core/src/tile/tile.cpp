@@ -47,6 +47,16 @@ void Tile::update(float _dt, const View& _view) {
     m_modelMatrix[3][1] = static_cast<float>(originRelativeMeters.y);
 
     m_mvp = _view.getViewProjectionMatrix() * m_modelMatrix;
+
+    // Swap in rasters that finished loading while a parent raster was shown
+    for (auto& raster : m_rasters) {
+        if (!raster.loading) { continue; }
+        if (auto texture = std::atomic_load(&raster.loading->texture)) {
+            raster.tileID = raster.loading->tileID;
+            raster.texture = std::move(texture);
+            raster.loading.reset();
+        }
+    }
 }
 
 void Tile::resetState() {
@@ -85,6 +95,35 @@ std::shared_ptr<Properties> Tile::getSelectionFeature(uint32_t _id) const {
     return nullptr;
 }
 
+bool Tile::isResident() const {
+    for (auto& mesh : m_geometry) {
+        if (mesh && !mesh->isResident()) { return false; }
+    }
+    for (auto& raster : m_rasters) {
+        if (raster.texture && !raster.texture->isUploaded()) { return false; }
+    }
+    return true;
+}
+
+size_t Tile::upload(RenderState& rs, size_t _maxBytes) {
+    size_t bytes = 0;
+
+    // The budget is checked after each upload, so that at least one
+    // mesh or raster is uploaded even when it exceeds @_maxBytes
+    for (auto& mesh : m_geometry) {
+        if (!mesh || mesh->isResident()) { continue; }
+        bytes += mesh->makeResident(rs);
+        if (bytes >= _maxBytes) { return bytes; }
+    }
+    for (auto& raster : m_rasters) {
+        if (!raster.texture || raster.texture->isUploaded()) { continue; }
+        raster.texture->bind(rs, 0);
+        bytes += raster.texture->bufferSize();
+        if (bytes >= _maxBytes) { return bytes; }
+    }
+    return bytes;
+}
+
 size_t Tile::getMemoryUsage() const {
     if (m_memoryUsage == 0) {
         for (auto& entry : m_geometry) {
@@ -16,6 +16,7 @@ namespace Tangram {
 
 class MapProjection;
 struct Properties;
+class RenderState;
 class Style;
 class View;
 struct StyledMesh;
@@ -23,9 +24,14 @@ struct StyledMesh;
 struct Raster {
     TileID tileID;
     std::shared_ptr<Texture> texture;
+    // Set when this is a parent raster that is sampled until the raster
+    // of the tile itself is decoded. The texture is published atomically;
+    // when loading failed it is the parent texture with the parent's tileID.
+    std::shared_ptr<Raster> loading;
 
     Raster(TileID tileID, std::shared_ptr<Texture> texture) : tileID(tileID), texture(texture) {}
-    Raster(Raster&& other) : tileID(other.tileID), texture(std::move(other.texture)) {}
+    Raster(Raster&& other) : tileID(other.tileID), texture(std::move(other.texture)),
+                             loading(std::move(other.loading)) {}
 
     bool isValid() const { return texture != nullptr; }
 };
@@ -81,11 +87,21 @@ public:
 
     void resetState();
 
+    /* Returns true when all meshes and raster textures are uploaded */
+    bool isResident() const;
+
+    /* Upload meshes and raster textures that are not resident until
+     * @_maxBytes are uploaded, returns the number of uploaded bytes */
+    size_t upload(RenderState& rs, size_t _maxBytes);
+
     /* Get the sum in bytes of static <Mesh>es */
     size_t getMemoryUsage() const;
 
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
+    /* Mark the tile as up-to-date with @_sourceGeneration when source changes did not affect it */
+    void setSourceGeneration(int64_t _sourceGeneration) { m_sourceGeneration = _sourceGeneration; }
+
     int32_t sourceID() const { return m_sourceId; }
 
     bool isProxy() const { return m_proxyState; }
@@ -102,7 +118,7 @@ private:
     const int32_t m_sourceId;
 
     /* State of the TileSource for which this tile was created */
-    const int64_t m_sourceGeneration;
+    int64_t m_sourceGeneration;
 
     bool m_proxyState = false;
 
@@ -9,11 +9,50 @@
 #include "scene/scene.h"
 #include "selection/featureSelection.h"
 #include "tile/tile.h"
+#include "util/hash.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
+#include <chrono>
+
 namespace Tangram {
 
+static bool hasFilterFunctions(const SceneLayer& _layer) {
+    for (const auto& instruction : _layer.filterProgram().instructions()) {
+        if (instruction.op == FilterProgram::Opcode::function) { return true; }
+    }
+    for (const auto& sublayer : _layer.sublayers()) {
+        if (hasFilterFunctions(sublayer)) { return true; }
+    }
+    return false;
+}
+
+static size_t featureSignature(const Feature& _feature, const SceneLayer& _layer) {
+    size_t seed = 0;
+    hash_combine(seed, &_layer);
+    hash_combine(seed, int(_feature.geometryType));
+    for (const auto& item : _feature.props.items()) {
+        hash_combine(seed, item.key);
+        if (item.value.is<std::string>()) {
+            hash_combine(seed, item.value.get<std::string>());
+        } else if (item.value.is<double>()) {
+            hash_combine(seed, item.value.get<double>());
+        }
+    }
+    return seed;
+}
+
+static bool equalProperties(const Properties& _a, const Properties& _b) {
+    const auto& a = _a.items();
+    const auto& b = _b.items();
+    if (a.size() != b.size()) { return false; }
+
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].key != b[i].key || !(a[i].value == b[i].value)) { return false; }
+    }
+    return true;
+}
+
 TileBuilder::TileBuilder(const Scene& _scene)
     : m_scene(_scene),
       m_styleContext(std::make_unique<StyleContext>()) {
@@ -35,6 +74,43 @@ void TileBuilder::init() {
     }
 }
 
+TileBuilder::ZoomLayers& TileBuilder::zoomLayers(int _zoom) {
+    auto it = m_zoomLayers.find(_zoom);
+    if (it != m_zoomLayers.end()) { return it->second; }
+
+    auto& zoomLayers = m_zoomLayers[_zoom];
+    auto& layers = zoomLayers.layers;
+    for (const auto& datalayer : m_scene.layers()) {
+        if (auto layer = datalayer.specializeZoom(_zoom)) {
+            layers.emplace_back(std::move(*layer), datalayer.source(), datalayer.collections());
+        }
+    }
+    for (const auto& layer : layers) {
+        m_memoLayers[&layer] = !hasFilterFunctions(layer);
+    }
+    return zoomLayers;
+}
+
+const TileBuilder::SourceLayers& TileBuilder::sourceLayers(ZoomLayers& _zoomLayers, const TileSource& _source) {
+    auto it = _zoomLayers.sources.find(_source.id());
+    if (it != _zoomLayers.sources.end()) { return it->second; }
+
+    auto& sourceLayers = _zoomLayers.sources[_source.id()];
+    for (const auto& datalayer : _zoomLayers.layers) {
+        if (datalayer.source() != _source.name()) { continue; }
+
+        uint32_t index = sourceLayers.layers.size();
+        sourceLayers.layers.push_back(&datalayer);
+
+        for (const auto& collection : datalayer.collections()) {
+            auto& entries = sourceLayers.collections[collection];
+            // A collection may be listed twice by one layer
+            if (entries.empty() || entries.back() != index) { entries.push_back(index); }
+        }
+    }
+    return sourceLayers;
+}
+
 StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     auto it = m_styleBuilder.find(_name);
     if (it == m_styleBuilder.end()) { return nullptr; }
@@ -42,59 +118,155 @@ StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     return it->second.get();
 }
 
+TileBuilder::RuleMemo* TileBuilder::findRuleMemo(const Feature& _feature, const SceneLayer& _layer) {
+
+    auto it = m_memoLayers.find(&_layer);
+    if (it == m_memoLayers.end() || !it->second) { return nullptr; }
+
+    auto& memo = m_ruleMemo[featureSignature(_feature, _layer)];
+
+    if (memo.count == 0) {
+        memo.feature = &_feature;
+        memo.layer = &_layer;
+    } else if (memo.layer != &_layer ||
+               memo.feature->geometryType != _feature.geometryType ||
+               !equalProperties(memo.feature->props, _feature.props)) {
+        return nullptr;
+    }
+
+    memo.count++;
+    return &memo;
+}
+
+bool TileBuilder::recordRuleMemo(RuleMemo& _memo, const Feature& _feature, const SceneLayer& _layer) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    _memo.cacheable = false;
+
+    if (m_ruleSet.match(_feature, _layer, *m_styleContext)) {
+
+        for (auto& rule : m_ruleSet.matchedRules()) {
+
+            StyleBuilder* style = getStyleBuilder(rule.getStyleName());
+
+            if (!style) {
+                LOGN("Invalid style %s", rule.getStyleName().c_str());
+                continue;
+            }
+
+            style->style().applyDefaultDrawRules(rule);
+
+            // JS function parameters must be evaluated for each feature
+            for (size_t n = 0; n < rule.activeCount; n++) {
+                if (rule.params[rule.activeKeys[n]].param->function >= 0) {
+                    _memo.rules.clear();
+                    return false;
+                }
+            }
+
+            if (!m_ruleSet.evaluateRuleForContext(rule, *m_styleContext)) {
+                continue;
+            }
+
+            // Keep the evaluated Stops: m_ruleSet reuses their storage for the next rule
+            for (size_t n = 0; n < rule.activeCount; n++) {
+                auto*& param = rule.params[rule.activeKeys[n]].param;
+                if (param->stops) {
+                    m_memoParams.push_back(*param);
+                    param = &m_memoParams.back();
+                }
+            }
+
+            _memo.rules.push_back({ style, rule });
+        }
+    }
+
+    std::chrono::duration<float, std::milli> cost = std::chrono::steady_clock::now() - start;
+
+    _memo.cost = cost.count();
+    _memo.cacheable = true;
+    return true;
+}
+
+bool TileBuilder::addFeature(const Feature& _feature, DrawRule& _rule, StyleBuilder& _style,
+                             uint32_t& _selectionColor) {
+
+    bool interactive = false;
+    if (_rule.get(StyleParamKey::interactive, interactive) && interactive) {
+        if (_selectionColor == 0) {
+            _selectionColor = m_scene.featureSelection()->nextColorIdentifier();
+        }
+        _rule.selectionColor = _selectionColor;
+        _rule.featureSelection = m_scene.featureSelection().get();
+    } else {
+        _rule.selectionColor = 0;
+    }
+
+    // build outline explicitly with outline style
+    const auto& outlineStyleName = _rule.findParameter(StyleParamKey::outline_style);
+    if (outlineStyleName) {
+        auto& styleName = outlineStyleName.value.get<std::string>();
+        auto* outlineStyle = getStyleBuilder(styleName);
+        if (!outlineStyle) {
+            LOGN("Invalid style %s", styleName.c_str());
+        } else {
+            _rule.isOutlineOnly = true;
+            outlineStyle->addFeature(_feature, _rule);
+            _rule.isOutlineOnly = false;
+        }
+    }
+
+    // build feature with style
+    return _style.addFeature(_feature, _rule);
+}
+
 void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer) {
 
-    // If no rules matched the feature, return immediately
-    if (!m_ruleSet.match(_feature, _layer, *m_styleContext)) { return; }
+    m_matchStats.features++;
 
     uint32_t selectionColor = 0;
     bool added = false;
 
-    // For each matched rule, find the style to be used and
-    // build the feature with the rule's parameters
-    for (auto& rule : m_ruleSet.matchedRules()) {
+    auto* memo = findRuleMemo(_feature, _layer);
 
-        StyleBuilder* style = getStyleBuilder(rule.getStyleName());
+    if (memo && memo->cacheable && memo->count > 1 &&
+        (memo->count > 2 || recordRuleMemo(*memo, _feature, _layer))) {
 
-        if (!style) {
-            LOGN("Invalid style %s", rule.getStyleName().c_str());
-            continue;
+        if (memo->count > 2) {
+            m_matchStats.memoHits++;
+            m_matchStats.savedTime += memo->cost;
         }
 
-        // Apply default draw rules defined for this style
-        style->style().applyDefaultDrawRules(rule);
-
-        if (!m_ruleSet.evaluateRuleForContext(rule, *m_styleContext)) {
-            continue;
+        for (auto& memoRule : memo->rules) {
+            added |= addFeature(_feature, memoRule.rule, *memoRule.style, selectionColor);
         }
 
-        bool interactive = false;
-        if (rule.get(StyleParamKey::interactive, interactive) && interactive) {
-            if (selectionColor == 0) {
-                selectionColor = m_scene.featureSelection()->nextColorIdentifier();
+    } else {
+
+        // If no rules matched the feature, return immediately
+        if (!m_ruleSet.match(_feature, _layer, *m_styleContext)) { return; }
+
+        // For each matched rule, find the style to be used and
+        // build the feature with the rule's parameters
+        for (auto& rule : m_ruleSet.matchedRules()) {
+
+            StyleBuilder* style = getStyleBuilder(rule.getStyleName());
+
+            if (!style) {
+                LOGN("Invalid style %s", rule.getStyleName().c_str());
+                continue;
             }
-            rule.selectionColor = selectionColor;
-            rule.featureSelection = m_scene.featureSelection().get();
-        } else {
-            rule.selectionColor = 0;
-        }
 
-        // build outline explicitly with outline style
-        const auto& outlineStyleName = rule.findParameter(StyleParamKey::outline_style);
-        if (outlineStyleName) {
-            auto& styleName = outlineStyleName.value.get<std::string>();
-            auto* outlineStyle = getStyleBuilder(styleName);
-            if (!outlineStyle) {
-                LOGN("Invalid style %s", styleName.c_str());
-            } else {
-                rule.isOutlineOnly = true;
-                outlineStyle->addFeature(_feature, rule);
-                rule.isOutlineOnly = false;
+            // Apply default draw rules defined for this style
+            style->style().applyDefaultDrawRules(rule);
+
+            if (!m_ruleSet.evaluateRuleForContext(rule, *m_styleContext)) {
+                continue;
             }
-        }
 
-        // build feature with style
-        added |= style->addFeature(_feature, rule);
+            added |= addFeature(_feature, rule, *style, selectionColor);
+        }
     }
 
     if (added && (selectionColor != 0)) {
@@ -105,33 +277,51 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
 std::unique_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData, const TileSource& _source) {
 
     m_selectionFeatures.clear();
+    m_ruleMemo.clear();
+    m_memoParams.clear();
+    m_matchStats = {};
 
     auto tile = std::make_unique<Tile>(_tileID, _source.id(), _source.generation());
 
     tile->initGeometry(int(m_scene.styles().size()));
 
     m_styleContext->setZoom(_tileID.s);
+    m_styleContext->clearFunctionCache();
 
     for (auto& builder : m_styleBuilder) {
         if (builder.second) { builder.second->setup(*tile); }
     }
 
-    for (const auto& datalayer : m_scene.layers()) {
+    const auto& sources = sourceLayers(zoomLayers(_tileID.s), _source);
+    const auto& layers = sources.layers;
 
-        if (datalayer.source() != _source.name()) { continue; }
+    // Collect the collections of each layer, which are then styled in
+    // scene layer order. Unnamed collections apply to all layers.
+    m_layerCollections.resize(layers.size());
+    for (auto& collections : m_layerCollections) { collections.clear(); }
 
-        for (const auto& collection : _tileData.layers) {
+    for (uint32_t i = 0; i < _tileData.layers.size(); i++) {
+        const auto& name = _tileData.layers[i].name;
 
-            if (!collection.name.empty()) {
-                const auto& dlc = datalayer.collections();
-                bool layerContainsCollection =
-                    std::find(dlc.begin(), dlc.end(), collection.name) != dlc.end();
-
-                if (!layerContainsCollection) { continue; }
+        if (name.empty()) {
+            for (size_t layer = 0; layer < layers.size(); layer++) {
+                m_layerCollections[layer].push_back(i);
             }
+            continue;
+        }
+
+        auto it = sources.collections.find(name);
+        if (it == sources.collections.end()) { continue; }
+
+        for (auto layer : it->second) {
+            m_layerCollections[layer].push_back(i);
+        }
+    }
 
-            for (const auto& feat : collection.features) {
-                applyStyling(feat, datalayer);
+    for (size_t layer = 0; layer < layers.size(); layer++) {
+        for (auto i : m_layerCollections[layer]) {
+            for (const auto& feat : _tileData.layers[i].features) {
+                applyStyling(feat, *layers[layer]);
             }
         }
     }
@@ -2,10 +2,14 @@
 
 #include "data/tileSource.h"
 #include "labels/labelCollider.h"
+#include "scene/dataLayer.h"
 #include "scene/styleContext.h"
 #include "scene/drawRule.h"
 #include "style/style.h"
 
+#include <deque>
+#include <unordered_map>
+
 namespace Tangram {
 
 class DataLayer;
@@ -27,16 +31,82 @@ public:
 
     const Scene& scene() const { return m_scene; }
 
+    const StyleContext& styleContext() const { return *m_styleContext; }
+
     // For testing
     TileBuilder(const Scene& _scene, StyleContext* _styleContext);
 
     void init();
 
+    // Rule matching statistics of the last built tile
+    struct MatchStats {
+        uint32_t features = 0;
+        // Number of features styled with memoized DrawRules
+        uint32_t memoHits = 0;
+        // Estimated time in ms saved by memo hits
+        float savedTime = 0;
+    };
+
+    const MatchStats& matchStats() const { return m_matchStats; }
+
 private:
 
+    // Matched and evaluated DrawRules of features with identical properties and
+    // geometry type within a layer. Only layers without JS filter functions and
+    // rules without JS function parameters are memoized, as everything else only
+    // depends on the feature properties and the zoom of the tile.
+    struct RuleMemo {
+        struct Rule {
+            StyleBuilder* style;
+            DrawRule rule;
+        };
+        // First feature with this signature
+        const Feature* feature = nullptr;
+        const SceneLayer* layer = nullptr;
+        // Times the signature was seen: the rules are recorded on the second
+        // occurrence, so that unique features do not pay for copying them.
+        uint32_t count = 0;
+        bool cacheable = true;
+        // Time in ms of matching and evaluating the rules
+        float cost = 0;
+        std::vector<Rule> rules;
+    };
+
     // Determine and apply DrawRules for a @_feature
     void applyStyling(const Feature& _feature, const SceneLayer& _layer);
 
+    // Build @_feature with the evaluated @_rule, returns whether any geometry was added
+    bool addFeature(const Feature& _feature, DrawRule& _rule, StyleBuilder& _style,
+                    uint32_t& _selectionColor);
+
+    // Returns the memo entry for @_feature, or null when the layer cannot be memoized
+    // or on a hash collision with a different signature
+    RuleMemo* findRuleMemo(const Feature& _feature, const SceneLayer& _layer);
+
+    // DataLayers of one TileSource
+    struct SourceLayers {
+        // Layers in scene order
+        std::vector<const DataLayer*> layers;
+        // Indices into 'layers' by collection name
+        std::unordered_map<std::string, std::vector<uint32_t>> collections;
+    };
+
+    struct ZoomLayers {
+        std::vector<DataLayer> layers;
+        // Layers by TileSource id, added for each source on its first tile
+        std::unordered_map<int32_t, SourceLayers> sources;
+    };
+
+    // Returns the scene layers specialized to styling zoom @_zoom
+    ZoomLayers& zoomLayers(int _zoom);
+
+    // Returns the layers of @_zoomLayers that apply to @_source
+    const SourceLayers& sourceLayers(ZoomLayers& _zoomLayers, const TileSource& _source);
+
+    // Match and evaluate the rules of @_feature into @_memo. Returns false when the
+    // rules depend on JS functions; the feature must then be styled as usual.
+    bool recordRuleMemo(RuleMemo& _memo, const Feature& _feature, const SceneLayer& _layer);
+
     const Scene& m_scene;
 
     std::unique_ptr<StyleContext> m_styleContext;
@@ -47,6 +117,21 @@ private:
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
 
     fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
+
+    // Per tile rule memo, keyed by feature signature
+    std::unordered_map<size_t, RuleMemo> m_ruleMemo;
+    // Storage for evaluated Stops of memoized rules
+    std::deque<StyleParam> m_memoParams;
+    // Whether a layer can be memoized, i.e. has no JS filter functions
+    fastmap<const SceneLayer*, bool> m_memoLayers;
+
+    // Scene layers with '$zoom' filters folded, by styling zoom
+    std::unordered_map<int, ZoomLayers> m_zoomLayers;
+
+    // Tile collections to style with each layer of a SourceLayers, reused per tile
+    std::vector<std::vector<uint32_t>> m_layerCollections;
+
+    MatchStats m_matchStats;
 };
 
 }
@@ -11,6 +11,7 @@
 #include "glm/gtx/norm.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #define DBG(...) LOG(__VA_ARGS__)
 
@@ -37,6 +38,9 @@ struct TileManager::TileEntry {
     std::shared_ptr<Tile> tile;
     std::shared_ptr<TileTask> task;
 
+    /* Tile of the completed task that waits for its meshes to be uploaded */
+    std::shared_ptr<Tile> uploading;
+
     /* A Counter for number of tiles this tile acts a proxy for */
     int32_t m_proxyCounter;
 
@@ -52,8 +56,12 @@ struct TileManager::TileEntry {
         return bool(task) && task->isCanceled();
     }
 
+    bool isUploading() const {
+        return bool(uploading);
+    }
+
     bool needsLoading() {
-        if (bool(tile)) { return false; }
+        if (bool(tile) || bool(uploading)) { return false; }
         if (!task) { return true; }
         if (task->isCanceled()) { return false; }
         if (task->needsLoading()) { return true; }
@@ -68,6 +76,8 @@ struct TileManager::TileEntry {
     // - task still exists
     // - task has a tile ready
     // - tile has all rasters set
+    // Then keep the tile until its meshes and rasters are uploaded by
+    // TileManager::uploadTiles(), while proxy tiles are drawn in its place.
     bool completeTileTask() {
         if (bool(task) && task->isReady()) {
 
@@ -76,9 +86,12 @@ struct TileManager::TileEntry {
             }
 
             task->complete();
-            tile = task->getTile();
+            uploading = task->getTile();
             task.reset();
+        }
 
+        if (bool(uploading) && uploading->isResident()) {
+            tile = std::move(uploading);
             return true;
         }
         return false;
@@ -391,21 +404,28 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
             // Can be removed once ClientDataSource is immutable
             if (entry.tile) {
                 auto sourceGeneration = entry.tile->sourceGeneration();
-                if ((sourceGeneration < generation) && !entry.isInProgress()) {
-                    // Tile needs update - enqueue for loading
-                    entry.task = _tileSet.source->createTask(visTileId);
-                    enqueueTask(_tileSet, visTileId, _view);
+                if ((sourceGeneration < generation) && !entry.isInProgress() &&
+                    !entry.isUploading()) {
+                    if (_tileSet.source->isOutdated(visTileId, sourceGeneration)) {
+                        // Tile needs update - enqueue for loading
+                        entry.task = _tileSet.source->createTask(visTileId);
+                        enqueueTask(_tileSet, visTileId, _view);
+                    } else {
+                        // Source changes did not affect this tile
+                        entry.tile->setSourceGeneration(generation);
+                    }
                 }
             } else if (entry.isCanceled()) {
                 auto sourceGeneration = entry.task->sourceGeneration();
-                if (sourceGeneration < generation) {
+                if ((sourceGeneration < generation) &&
+                    _tileSet.source->isOutdated(visTileId, sourceGeneration)) {
                     // Tile needs update - enqueue for loading
                     entry.task = _tileSet.source->createTask(visTileId);
                     enqueueTask(_tileSet, visTileId, _view);
                 }
             }
 
-            if (entry.isInProgress()) {
+            if (entry.isInProgress() || entry.isUploading()) {
                 m_tilesInProgress++;
             }
 
@@ -510,6 +530,66 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
     }
 }
 
+float TileManager::screenCoverage(const Tile& _tile, const View& _view) {
+
+    glm::vec2 min(1.f), max(-1.f);
+
+    for (auto corner : { glm::dvec2(0, 0), glm::dvec2(1, 0), glm::dvec2(0, 1), glm::dvec2(1, 1) }) {
+        auto meters = _view.getRelativeMeters(_tile.getOrigin() + corner * _tile.getScale());
+        auto clip = _view.getViewProjectionMatrix() * glm::vec4(meters.x, meters.y, 0.f, 1.f);
+
+        // Corner behind the camera: The tile covers most of the screen
+        if (clip.w <= 0) { return 1.f; }
+
+        glm::vec2 ndc = glm::clamp(glm::vec2(clip) / clip.w, -1.f, 1.f);
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+
+    if (max.x < min.x || max.y < min.y) { return 0.f; }
+
+    // Fraction of the viewport covered by the screen bounds of the tile
+    return (max.x - min.x) * (max.y - min.y) / 4.f;
+}
+
+bool TileManager::uploadTiles(RenderState& _rs, const View& _view) {
+
+    m_uploadQueue.clear();
+    bool pending = false;
+
+    for (auto& tileSet : m_tileSets) {
+        for (auto& it : tileSet.tiles) {
+            auto& tile = it.second.uploading;
+            if (!tile) { continue; }
+
+            pending = true;
+            if (!tile->isResident()) {
+                m_uploadQueue.emplace_back(screenCoverage(*tile, _view), tile.get());
+            }
+        }
+    }
+
+    // Upload the tiles covering most of the screen first
+    std::sort(m_uploadQueue.begin(), m_uploadQueue.end(),
+              [](auto& a, auto& b) { return a.first > b.first; });
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+
+    for (auto& entry : m_uploadQueue) {
+        bytes += entry.second->upload(_rs, m_uploadBudget.maxBytes - bytes);
+
+        std::chrono::duration<float, std::milli> time = std::chrono::steady_clock::now() - start;
+        if (bytes >= m_uploadBudget.maxBytes || time.count() >= m_uploadBudget.maxTime) {
+            break;
+        }
+    }
+
+    m_uploadQueue.clear();
+
+    return pending;
+}
+
 void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
                               const ViewState& _view) {
 
@@ -554,7 +634,8 @@ bool TileManager::addTile(TileSet& _tileSet, const TileID& _tileID) {
     auto tile = m_tileCache->get(_tileSet.source->id(), _tileID);
 
     if (tile) {
-        if (tile->sourceGeneration() == _tileSet.source->generation()) {
+        if (!_tileSet.source->isOutdated(_tileID, tile->sourceGeneration())) {
+            tile->setSourceGeneration(_tileSet.source->generation());
             m_tiles.push_back(tile);
 
             // Reset tile on potential internal dynamic data set
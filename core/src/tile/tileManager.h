@@ -18,6 +18,7 @@ class Platform;
 
 namespace Tangram {
 
+class RenderState;
 class TileSource;
 class TileCache;
 class View;
@@ -32,6 +33,9 @@ class TileManager {
 
     const static size_t DEFAULT_CACHE_SIZE = 32*1024*1024; // 32 MB
 
+    constexpr static size_t DEFAULT_UPLOAD_BYTES = 2*1024*1024; // 2 MB per frame
+    constexpr static float DEFAULT_UPLOAD_TIME = 4.f; // 4 ms per frame
+
 public:
 
     TileManager(Platform& platform, TileTaskQueue& _tileWorker);
@@ -50,6 +54,21 @@ public:
 
     void cancelTileTasks();
 
+    /* Uploads the meshes of loaded tiles within the upload budget of a frame, starting
+     * with the tiles covering the largest part of the screen. Tiles are drawn once
+     * all their meshes are uploaded, until then their proxy tiles are drawn.
+     * Returns true while tiles are waiting to be uploaded or to be drawn.
+     */
+    bool uploadTiles(RenderState& _rs, const View& _view);
+
+    /* @_maxBytes: Number of bytes to upload per frame
+     * @_maxTime: Time in milliseconds after which no more tiles are uploaded in a frame
+     * At least one mesh is uploaded per frame.
+     */
+    void setUploadBudget(size_t _maxBytes, float _maxTime) {
+        m_uploadBudget = { _maxBytes, _maxTime };
+    }
+
     /* Returns the set of currently visible tiles */
     const auto& getVisibleTiles() const { return m_tiles; }
 
@@ -127,6 +146,9 @@ protected:
      */
     void clearProxyTiles(TileSet& _tileSet, const TileID& _tileID, TileEntry& _tile, std::vector<TileID>& _removes);
 
+    /* Returns the fraction of the viewport covered by the screen bounds of @_tile */
+    static float screenCoverage(const Tile& _tile, const View& _view);
+
     int32_t m_tilesInProgress = 0;
 
     std::vector<TileSet> m_tileSets;
@@ -145,6 +167,15 @@ protected:
      */
     TileTaskCb m_dataCallback;
 
+    struct UploadBudget {
+        size_t maxBytes;
+        float maxTime;
+    };
+    UploadBudget m_uploadBudget = { DEFAULT_UPLOAD_BYTES, DEFAULT_UPLOAD_TIME };
+
+    /* Temporary list of tiles to upload, with their screen coverage */
+    std::vector<std::pair<float, Tile*>> m_uploadQueue;
+
     /* Temporary list of tiles that need to be loaded */
     std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
 
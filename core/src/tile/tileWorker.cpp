@@ -51,7 +51,7 @@ void TileWorker::run(Worker* instance) {
                 LOGTInit();
                 builder = std::move(instance->tileBuilder);
                 builder->init();
-                LOGT("Took init of TileBuilder");
+                LOGT("Took init of TileBuilder, JS heap: %d bytes", int(builder->styleContext().jsHeapSize()));
             }
             // Check if thread should stop
             if (!m_running) {
@@ -94,7 +94,9 @@ void TileWorker::run(Worker* instance) {
 
         LOGTInit(">>> process %s", task->tileId().toString().c_str());
         task->process(*builder);
-        LOGT("<<< process %s", task->tileId().toString().c_str());
+        LOGT("<<< process %s - rule memo hits %d/%d, saved %.2fms", task->tileId().toString().c_str(),
+             builder->matchStats().memoHits, builder->matchStats().features,
+             builder->matchStats().savedTime);
 
         m_platform.requestRender();
     }
@@ -40,13 +40,17 @@ struct Color {
         return result;
     }
 
+    // Interpolates all channels with 8 bit precision, two at a time in
+    // the lanes of a 32-bit integer. '_a' is clamped to [0, 1].
     static Color mix(const Color& _x, const Color& _y, float _a) {
-        return Color(
-            _x.r * (1 - _a) + _y.r * _a,
-            _x.g * (1 - _a) + _y.g * _a,
-            _x.b * (1 - _a) + _y.b * _a,
-            _x.a * (1 - _a) + _y.a * _a
-        );
+        uint32_t w = _a <= 0 ? 0 : _a >= 1 ? 256 : static_cast<uint32_t>(_a * 256 + 0.5f);
+        uint32_t x = _x.abgr, y = _y.abgr;
+
+        // 0x80 rounds each channel to the nearest value
+        uint32_t lo = ((x & 0x00ff00ff) * (256 - w) + (y & 0x00ff00ff) * w + 0x00800080) >> 8;
+        uint32_t hi = ((x >> 8) & 0x00ff00ff) * (256 - w) + ((y >> 8) & 0x00ff00ff) * w + 0x00800080;
+
+        return Color((lo & 0x00ff00ff) | (hi & 0xff00ff00));
     }
 
 };
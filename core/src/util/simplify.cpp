@@ -0,0 +1,99 @@
+#include "util/simplify.h"
+
+#include "tile/tileID.h"
+#include "util/geom.h"
+#include "util/mapProjection.h"
+
+#include <cmath>
+
+namespace Tangram {
+
+static bool onTileEdge(const Point& _p) {
+    return _p.x <= 0.f || _p.x >= 1.f || _p.y <= 0.f || _p.y >= 1.f;
+}
+
+float Simplifier::tileTolerance(float _pixels, const TileID& _tileId, float _pixelScale) {
+    // An overzoomed tile is styled and drawn at a larger size than its data zoom
+    float pixelsPerTile = MapProjection::tileSize() * _pixelScale * std::exp2(_tileId.s - _tileId.z);
+    return _pixels / pixelsPerTile;
+}
+
+const Line& Simplifier::simplify(const Line& _line) {
+    if (tolerance <= 0.f || _line.size() < 3) { return _line; }
+
+    return simplify(_line, m_line) ? m_line : _line;
+}
+
+const Polygon& Simplifier::simplify(const Polygon& _polygon) {
+    if (tolerance <= 0.f) { return _polygon; }
+
+    m_polygon.resize(_polygon.size());
+
+    bool simplified = false;
+    for (size_t i = 0; i < _polygon.size(); i++) {
+        const auto& ring = _polygon[i];
+        auto& out = m_polygon[i];
+
+        // A closed ring needs at least a triangle
+        if (ring.size() > 4 && simplify(ring, out) && out.size() >= 4) {
+            simplified = true;
+        } else {
+            out.assign(ring.begin(), ring.end());
+        }
+    }
+    return simplified ? m_polygon : _polygon;
+}
+
+bool Simplifier::simplify(const Line& _line, Line& _out) {
+    const size_t n = _line.size();
+
+    m_keep.assign(n, 0);
+    m_keep[0] = 1;
+    m_keep[n - 1] = 1;
+    for (size_t i = 1; i < n - 1; i++) {
+        if (onTileEdge(_line[i])) { m_keep[i] = 1; }
+    }
+
+    // Simplify the vertices between each pair of fixed vertices
+    m_ranges.clear();
+    size_t start = 0;
+    for (size_t i = 1; i < n; i++) {
+        if (!m_keep[i]) { continue; }
+        if (i - start > 1) { m_ranges.emplace_back(start, i); }
+        start = i;
+    }
+
+    const float toleranceSq = tolerance * tolerance;
+
+    while (!m_ranges.empty()) {
+        auto range = m_ranges.back();
+        m_ranges.pop_back();
+
+        const auto& a = _line[range.first];
+        const auto& b = _line[range.second];
+
+        float maxDistSq = 0.f;
+        uint32_t maxIndex = range.first;
+        for (uint32_t i = range.first + 1; i < range.second; i++) {
+            float distSq = pointSegmentDistanceSq(_line[i], a, b);
+            if (distSq > maxDistSq) {
+                maxDistSq = distSq;
+                maxIndex = i;
+            }
+        }
+
+        if (maxDistSq <= toleranceSq) { continue; }
+
+        m_keep[maxIndex] = 1;
+        if (maxIndex - range.first > 1) { m_ranges.emplace_back(range.first, maxIndex); }
+        if (range.second - maxIndex > 1) { m_ranges.emplace_back(maxIndex, range.second); }
+    }
+
+    _out.clear();
+    for (size_t i = 0; i < n; i++) {
+        if (m_keep[i]) { _out.push_back(_line[i]); }
+    }
+    return _out.size() < n;
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Tangram {
+
+struct TileID;
+
+/* Douglas-Peucker simplification of lines and polygon rings in tile units.
+ *
+ * Vertices on or beyond the tile boundary are always kept, so that clipped
+ * features continue seamlessly into neighbouring tiles and tile edges stay
+ * recognizable for the builders. Holds scratch buffers to be reused by a
+ * StyleBuilder for all features of a tile.
+ */
+class Simplifier {
+
+public:
+
+    // Maximum distance in tile units between a removed vertex and the simplified line.
+    // Simplification is disabled when this is zero.
+    float tolerance = 0.f;
+
+    // Returns the tolerance in tile units for _pixels device pixels, when tile
+    // _tileId is drawn at its styling zoom with the given pixel scale.
+    static float tileTolerance(float _pixels, const TileID& _tileId, float _pixelScale);
+
+    // Returns _line when nothing is to be removed, otherwise a reference to the
+    // simplified line, which is valid until the next call.
+    const Line& simplify(const Line& _line);
+
+    // Returns _polygon when nothing is to be removed, otherwise a reference to the
+    // simplified polygon, which is valid until the next call. Rings that would
+    // degenerate are kept as they are.
+    const Polygon& simplify(const Polygon& _polygon);
+
+private:
+
+    // Writes the simplified _line to _out. Returns false when no vertex was removed.
+    bool simplify(const Line& _line, Line& _out);
+
+    Line m_line;
+    Polygon m_polygon;
+
+    std::vector<uint8_t> m_keep;
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
+};
+
+}
@@ -1,7 +1,15 @@
-#include "gl.h"
+#include "gl_mock.h"
+
+#include <thread>
 
 namespace Tangram {
 
+GLMock::Counters GLMock::counters;
+std::chrono::microseconds GLMock::deleteBuffersTime{0};
+
+// Shaders and programs compile and link successfully
+static GLuint s_lastObject = 0;
+
 GLenum GL::getError() {
     return 0;
 }
@@ -58,10 +66,10 @@ void GL::deleteProgram(GLuint program) {
 void GL::deleteShader(GLuint shader) {
 }
 GLuint GL::createShader(GLenum type) {
-    return 0;
+    return ++s_lastObject;
 }
 GLuint GL::createProgram() {
-    return 0;
+    return ++s_lastObject;
 }
 
 void GL::compileShader(GLuint shader) {
@@ -84,20 +92,38 @@ GLint GL::getAttribLocation(GLuint program, const GLchar *name) {
     return 0;
 }
 void GL::getProgramiv(GLuint program, GLenum pname, GLint *params) {
+    *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
 }
 void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
 }
 
 // Buffers
 void GL::bindBuffer(GLenum target, GLuint buffer) {
 }
 void GL::deleteBuffers(GLsizei n, const GLuint *buffers) {
+    GLMock::counters.deleteBuffers += n;
+    if (GLMock::deleteBuffersTime.count() > 0) {
+        std::this_thread::sleep_for(GLMock::deleteBuffersTime);
+    }
 }
 void GL::genBuffers(GLsizei n, GLuint *buffers) {
+    GLMock::counters.genBuffers += n;
+    for (GLsizei i = 0; i < n; i++) { buffers[i] = ++s_lastObject; }
 }
 void GL::bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    GLMock::counters.bufferData++;
+    if (target == GL_ARRAY_BUFFER && data) {
+        auto bytes = static_cast<const GLbyte*>(data);
+        GLMock::counters.arrayBufferData.assign(bytes, bytes + size);
+    }
 }
 void GL::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    GLMock::counters.bufferSubData++;
+    if (target == GL_ARRAY_BUFFER && data) {
+        auto bytes = static_cast<const GLbyte*>(data);
+        GLMock::counters.arrayBufferData.assign(bytes, bytes + size);
+    }
 }
 void GL::readPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                     GLenum format, GLenum type, GLvoid* pixels) {
@@ -109,16 +135,21 @@ void GL::bindTexture(GLenum target, GLuint texture ) {
 void GL::activeTexture(GLenum texture) {
 }
 void GL::genTextures(GLsizei n, GLuint *textures ) {
+    GLMock::counters.genTextures += n;
+    for (GLsizei i = 0; i < n; i++) { textures[i] = ++s_lastObject; }
 }
 void GL::deleteTextures(GLsizei n, const GLuint *textures) {
+    GLMock::counters.deleteTextures += n;
 }
 void GL::texParameteri(GLenum target, GLenum pname, GLint param ) {
 }
 void GL::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
                     GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+    GLMock::counters.texImage2D++;
 }
 void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                        GLenum format, GLenum type, const GLvoid *pixels) {
+    GLMock::counters.texSubImage2D++;
 }
 void GL::generateMipmap(GLenum target) {
 }
@@ -132,8 +163,11 @@ void GL::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean no
 }
 
 void GL::drawArrays(GLenum mode, GLint first, GLsizei count ) {
+    GLMock::counters.drawArrays++;
 }
 void GL::drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices ) {
+    GLMock::counters.drawElements++;
+    if (type == GL_UNSIGNED_INT) { GLMock::counters.drawElementsUInt++; }
 }
 
 void GL::uniform1f(GLint location, GLfloat v0) {
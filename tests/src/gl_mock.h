@@ -0,0 +1,38 @@
+#pragma once
+
+#include "gl.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace Tangram {
+namespace GLMock {
+
+// Calls recorded by the GL mock, reset with 'counters = {}'
+struct Counters {
+    size_t drawArrays = 0;
+    size_t drawElements = 0;
+    size_t drawElementsUInt = 0; // drawElements calls with 32 bit indices
+    size_t genBuffers = 0;
+    size_t deleteBuffers = 0;
+    size_t bufferData = 0;
+    size_t bufferSubData = 0;
+    size_t genTextures = 0;
+    size_t deleteTextures = 0;
+    size_t texImage2D = 0;
+    size_t texSubImage2D = 0;
+
+    // Data of the last upload to GL_ARRAY_BUFFER
+    std::vector<GLbyte> arrayBufferData;
+
+    size_t drawCalls() const { return drawArrays + drawElements; }
+};
+
+extern Counters counters;
+
+// Time taken by each deleteBuffers call, to test time budgets
+extern std::chrono::microseconds deleteBuffersTime;
+
+}
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+
+#include "gl/bufferArena.h"
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl_mock.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+static const GLsizeiptr pageSize = 1024;
+
+TEST_CASE("BufferArena suballocates from one page", "[Core][BufferArena]") {
+    RenderState rs;
+    BufferArena arena(GL_ARRAY_BUFFER, pageSize);
+    std::vector<GLbyte> data(pageSize);
+
+    GLMock::counters = {};
+    auto a = arena.allocate(rs, 100, data.data());
+    auto b = arena.allocate(rs, 10, data.data());
+    auto c = arena.allocate(rs, 200, data.data());
+
+    REQUIRE(arena.pageCount() == 1);
+    REQUIRE(GLMock::counters.genBuffers == 1);
+    REQUIRE(GLMock::counters.bufferData == 1);
+    REQUIRE(GLMock::counters.bufferSubData == 3);
+
+    REQUIRE(a.buffer == b.buffer);
+    REQUIRE(b.buffer == c.buffer);
+
+    // Allocations are aligned and do not overlap
+    for (auto& alloc : { a, b, c }) {
+        REQUIRE(alloc.offset % BufferArena::alignment == 0);
+    }
+    REQUIRE(a.offset + a.size <= b.offset);
+    REQUIRE(b.offset + b.size <= c.offset);
+    REQUIRE(arena.usedBytes() == 112 + 16 + 208);
+
+    arena.dispose();
+    REQUIRE(GLMock::counters.deleteBuffers == 1);
+}
+
+TEST_CASE("BufferArena reclaims freed ranges on flush", "[Core][BufferArena]") {
+    RenderState rs;
+    BufferArena arena(GL_ELEMENT_ARRAY_BUFFER, pageSize);
+    std::vector<GLbyte> data(pageSize);
+
+    auto a = arena.allocate(rs, 256, data.data());
+    auto b = arena.allocate(rs, 256, data.data());
+    auto c = arena.allocate(rs, 256, data.data());
+
+    // Freed ranges are not reused before the next flush
+    arena.free(b);
+    auto d = arena.allocate(rs, 256, data.data());
+    REQUIRE(d.offset == 768);
+
+    arena.flush();
+    auto e = arena.allocate(rs, 256, data.data());
+    REQUIRE(e.offset == b.offset);
+    REQUIRE(arena.pageCount() == 1);
+
+    // Adjacent ranges are merged
+    arena.free(a);
+    arena.free(e);
+    arena.flush();
+    auto f = arena.allocate(rs, 512, data.data());
+    REQUIRE(f.offset == 0);
+    REQUIRE(arena.pageCount() == 1);
+
+    // The last empty page is kept
+    GLMock::counters = {};
+    arena.free(c);
+    arena.free(d);
+    arena.free(f);
+    arena.flush();
+    REQUIRE(arena.pageCount() == 1);
+    REQUIRE(arena.usedBytes() == 0);
+    REQUIRE(GLMock::counters.deleteBuffers == 0);
+
+    arena.dispose();
+}
+
+TEST_CASE("BufferArena adds pages when full and deletes unused pages", "[Core][BufferArena]") {
+    RenderState rs;
+    BufferArena arena(GL_ARRAY_BUFFER, pageSize);
+    std::vector<GLbyte> data(4 * pageSize);
+
+    GLMock::counters = {};
+    auto a = arena.allocate(rs, 800, data.data());
+    auto b = arena.allocate(rs, 800, data.data());
+    REQUIRE(arena.pageCount() == 2);
+    REQUIRE(a.buffer != b.buffer);
+
+    // Large allocations get a page of their own
+    auto c = arena.allocate(rs, 4 * pageSize, data.data());
+    REQUIRE(arena.pageCount() == 3);
+    REQUIRE(c.offset == 0);
+    REQUIRE(GLMock::counters.genBuffers == 3);
+
+    arena.free(a);
+    arena.free(b);
+    arena.free(c);
+    arena.flush();
+    REQUIRE(arena.pageCount() == 1);
+    REQUIRE(GLMock::counters.deleteBuffers == 2);
+
+    // Allocations of pages dropped after context loss are ignored
+    auto d = arena.allocate(rs, 100, data.data());
+    arena.invalidate();
+    arena.free(d);
+    arena.flush();
+    REQUIRE(arena.pageCount() == 0);
+    REQUIRE(GLMock::counters.deleteBuffers == 2);
+}
+
+struct ArenaVertex {
+    float x, y;
+};
+
+TEST_CASE("Static meshes share buffers of the RenderState arenas", "[Core][BufferArena]") {
+    auto layout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+    }));
+
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setShaderSource("vertex", "fragment");
+
+    GLMock::counters = {};
+    {
+        std::vector<std::unique_ptr<Mesh<ArenaVertex>>> meshes;
+        for (int i = 0; i < 10; i++) {
+            auto mesh = std::make_unique<Mesh<ArenaVertex>>(layout, GL_TRIANGLES);
+            mesh->compile(MeshData<ArenaVertex>({ 0, 1, 2 }, { {0,0}, {1,0}, {0,1} }));
+            REQUIRE(mesh->draw(rs, shader, false));
+            meshes.push_back(std::move(mesh));
+        }
+
+        // One page for vertices and one for indices
+        REQUIRE(GLMock::counters.genBuffers == 2);
+        REQUIRE(GLMock::counters.bufferSubData == 20);
+        REQUIRE(GLMock::counters.drawElements == 10);
+        REQUIRE(rs.vertexArena(layout->getStride()).usedBytes() == 10 * 32);
+        REQUIRE(rs.indexArena().usedBytes() == 10 * 16);
+    }
+
+    rs.flushResourceDeletion();
+    REQUIRE(rs.vertexArena(layout->getStride()).usedBytes() == 0);
+    REQUIRE(rs.indexArena().usedBytes() == 0);
+    REQUIRE(GLMock::counters.deleteBuffers == 0);
+
+    // Dynamic meshes keep their own buffers
+    Mesh<ArenaVertex> mesh(layout, GL_TRIANGLES, GL_DYNAMIC_DRAW);
+    mesh.compile(MeshData<ArenaVertex>({ 0, 1, 2 }, { {0,0}, {1,0}, {0,1} }));
+    REQUIRE(mesh.draw(rs, shader, false));
+    REQUIRE(GLMock::counters.genBuffers == 4);
+}
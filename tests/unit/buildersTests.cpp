@@ -0,0 +1,124 @@
+#include "catch.hpp"
+
+#include "util/builders.h"
+
+using namespace Tangram;
+
+struct Triangulation {
+    std::vector<glm::vec3> vertices;
+    std::vector<uint16_t> indices;
+
+    float area(size_t _triangle) const {
+        const auto& a = vertices[indices[_triangle * 3]];
+        const auto& b = vertices[indices[_triangle * 3 + 1]];
+        const auto& c = vertices[indices[_triangle * 3 + 2]];
+        return 0.5f * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    }
+
+    size_t numTriangles() const { return indices.size() / 3; }
+};
+
+static Triangulation triangulate(const Polygon& _polygon) {
+    Triangulation result;
+    PolygonBuilder builder;
+    builder.useTexCoords = false;
+
+    Builders::buildPolygon(_polygon, 0.f, builder,
+        [&](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+            result.vertices.push_back(coord);
+        });
+
+    result.indices = builder.indices;
+    REQUIRE(result.vertices.size() == builder.numVertices);
+    return result;
+}
+
+TEST_CASE("Convex polygons are triangulated as a fan", "[Builders]") {
+    Polygon ccw = { { {0.1f, 0.1f}, {0.5f, 0.1f}, {0.5f, 0.3f}, {0.1f, 0.3f}, {0.1f, 0.1f} } };
+    Polygon cw = { { {0.1f, 0.1f}, {0.1f, 0.3f}, {0.5f, 0.3f}, {0.5f, 0.1f}, {0.1f, 0.1f} } };
+
+    for (auto& polygon : { ccw, cw }) {
+        auto result = triangulate(polygon);
+        REQUIRE(result.vertices.size() == 4);
+        REQUIRE(result.numTriangles() == 2);
+        // Triangles have the counter-clockwise winding of earcut
+        for (size_t i = 0; i < result.numTriangles(); i++) {
+            CHECK(result.area(i) == Approx(0.04f));
+        }
+    }
+
+    // Collinear points are not used
+    Polygon collinear = { { {0.1f, 0.1f}, {0.3f, 0.1f}, {0.5f, 0.1f}, {0.5f, 0.3f}, {0.1f, 0.3f} } };
+    auto result = triangulate(collinear);
+    REQUIRE(result.vertices.size() == 4);
+    REQUIRE(result.numTriangles() == 2);
+}
+
+TEST_CASE("Concave polygons and polygons with holes are triangulated by earcut", "[Builders]") {
+    // L-shape
+    Polygon concave = { { {0.f, 0.f}, {0.2f, 0.f}, {0.2f, 0.1f}, {0.1f, 0.1f},
+                          {0.1f, 0.2f}, {0.f, 0.2f}, {0.f, 0.f} } };
+    Polygon holes = { { {0.f, 0.f}, {0.4f, 0.f}, {0.4f, 0.4f}, {0.f, 0.4f}, {0.f, 0.f} },
+                      { {0.1f, 0.1f}, {0.1f, 0.3f}, {0.3f, 0.3f}, {0.3f, 0.1f}, {0.1f, 0.1f} } };
+
+    auto result = triangulate(concave);
+    REQUIRE(result.numTriangles() == 4);
+    float area = 0;
+    for (size_t i = 0; i < result.numTriangles(); i++) {
+        CHECK(result.area(i) > 0);
+        area += result.area(i);
+    }
+    CHECK(area == Approx(0.03f));
+
+    result = triangulate(holes);
+    REQUIRE(result.numTriangles() == 8);
+    area = 0;
+    for (size_t i = 0; i < result.numTriangles(); i++) {
+        area += result.area(i);
+    }
+    CHECK(area == Approx(0.12f));
+}
+
+TEST_CASE("Walls along edges shared with an equal or higher extrusion are hidden", "[Builders]") {
+    // Two adjacent squares, sharing the edge at x = 0.3
+    Polygon left = { { {0.1f, 0.1f}, {0.3f, 0.1f}, {0.3f, 0.3f}, {0.1f, 0.3f}, {0.1f, 0.1f} } };
+    Polygon right = { { {0.3f, 0.1f}, {0.5f, 0.1f}, {0.5f, 0.3f}, {0.3f, 0.3f}, {0.3f, 0.1f} } };
+
+    SharedWalls walls;
+    uint32_t a = walls.add(left, 0.f, 0.1f);
+    uint32_t b = walls.add(right, 0.f, 0.1f);
+
+    CHECK(walls.isHidden(a, {0.3f, 0.1f}, {0.3f, 0.3f}));
+    CHECK(walls.isHidden(b, {0.3f, 0.3f}, {0.3f, 0.1f}));
+    CHECK_FALSE(walls.isHidden(a, {0.1f, 0.1f}, {0.3f, 0.1f}));
+    CHECK_FALSE(walls.isHidden(b, {0.5f, 0.1f}, {0.5f, 0.3f}));
+
+    // Only the wall of the lower extrusion is hidden
+    walls.clear();
+    a = walls.add(left, 0.f, 0.1f);
+    b = walls.add(right, 0.f, 0.3f);
+
+    CHECK(walls.isHidden(a, {0.3f, 0.1f}, {0.3f, 0.3f}));
+    CHECK_FALSE(walls.isHidden(b, {0.3f, 0.3f}, {0.3f, 0.1f}));
+
+    // Walls of a polygon without neighbors are all built
+    walls.clear();
+    a = walls.add(left, 0.f, 0.1f);
+
+    PolygonBuilder builder;
+    size_t numVertices = 0;
+    Builders::buildPolygonExtrusion(left, 0.f, 0.1f, builder,
+        [&](const glm::vec3&, const glm::vec3&, const glm::vec2&) { numVertices++; },
+        [&](const glm::vec2& _a, const glm::vec2& _b) { return walls.isHidden(a, _a, _b); });
+    CHECK(numVertices == 16);
+
+    // and the shared wall is skipped when the neighbor is added
+    b = walls.add(right, 0.f, 0.1f);
+    builder.clear();
+    numVertices = 0;
+    Builders::buildPolygonExtrusion(left, 0.f, 0.1f, builder,
+        [&](const glm::vec3&, const glm::vec3&, const glm::vec2&) { numVertices++; },
+        [&](const glm::vec2& _a, const glm::vec2& _b) { return walls.isHidden(a, _a, _b); });
+    CHECK(numVertices == 12);
+    CHECK(builder.indices.size() == 18);
+}
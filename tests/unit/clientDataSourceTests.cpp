@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "data/clientDataSource.h"
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "mockPlatform.h"
+
+using namespace Tangram;
+
+static std::shared_ptr<TileData> parseTile(ClientDataSource& _source, TileID _tileId) {
+    auto task = _source.createTask(_tileId);
+    return static_cast<TileSource&>(_source).parse(*task);
+}
+
+TEST_CASE("ClientDataSource invalidates only tiles affected by feature updates", "[ClientDataSource]") {
+
+    MockPlatform platform;
+    auto source = std::make_shared<ClientDataSource>(platform, "test", "");
+
+    TileID northWest(0, 0, 1);
+    TileID southEast(1, 1, 1);
+
+    source->setPointFeature(1, Properties(), LngLat(-90, 45));
+    source->setPointFeature(2, Properties(), LngLat(90, -45));
+    source->generateTiles();
+
+    auto generation = source->generation();
+    REQUIRE(!source->isOutdated(northWest, generation));
+    REQUIRE(!source->isOutdated(southEast, generation));
+
+    // Move feature 1 within the north-west tile
+    source->setPointFeature(1, Properties(), LngLat(-91, 46));
+    source->generateTiles();
+
+    REQUIRE(source->generation() > generation);
+    REQUIRE(source->isOutdated(northWest, generation));
+    REQUIRE(!source->isOutdated(southEast, generation));
+
+    generation = source->generation();
+
+    source->removeFeature(2);
+    source->generateTiles();
+
+    REQUIRE(!source->isOutdated(northWest, generation));
+    REQUIRE(source->isOutdated(southEast, generation));
+
+    REQUIRE(parseTile(*source, northWest)->layers[0].features.size() == 1);
+    REQUIRE(parseTile(*source, southEast)->layers[0].features.empty());
+}
+
+TEST_CASE("ClientDataSource outdates all tiles when features are added in bulk", "[ClientDataSource]") {
+
+    MockPlatform platform;
+    auto source = std::make_shared<ClientDataSource>(platform, "test", "");
+
+    source->setPointFeature(1, Properties(), LngLat(-90, 45));
+    source->generateTiles();
+
+    auto generation = source->generation();
+
+    source->addPointFeature(Properties(), LngLat(-90, 45));
+    source->generateTiles();
+
+    REQUIRE(source->isOutdated(TileID(1, 1, 1), generation));
+
+    // The feature with a client-defined id is still updated after the full rebuild
+    generation = source->generation();
+
+    source->setPointFeature(1, Properties(), LngLat(90, -45));
+    source->generateTiles();
+
+    REQUIRE(source->isOutdated(TileID(1, 1, 1), generation));
+    REQUIRE(parseTile(*source, TileID(0, 0, 1))->layers[0].features.size() == 1);
+    REQUIRE(parseTile(*source, TileID(1, 1, 1))->layers[0].features.size() == 1);
+}
@@ -0,0 +1,128 @@
+#include "catch.hpp"
+
+#include "gl/renderState.h"
+#include "scene/drawList.h"
+#include "style/polygonStyle.h"
+#include "tile/tile.h"
+#include "view/view.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Tangram;
+
+struct DrawListTestMesh : public StyledMesh {
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) override { return true; }
+    size_t bufferSize() const override { return 0; }
+};
+
+TEST_CASE( "Draw list sort keys", "[Core][DrawList]" ) {
+
+    auto opaque = DrawList::sortKey(Blending::opaque, 10, 1, 5, 1.f);
+    auto add = DrawList::sortKey(Blending::add, 0, 0, 0, 0.f);
+    auto overlay = DrawList::sortKey(Blending::overlay, -1, 0, 1, 0.f);
+    auto inlay = DrawList::sortKey(Blending::inlay, 3, 0, 2, 0.f);
+
+    // Opaque draws come first, blended draws are sorted by blend order, then blend mode
+    REQUIRE(opaque < add);
+    REQUIRE(overlay < add);
+    REQUIRE(add < inlay);
+    REQUIRE(DrawList::sortKey(Blending::add, 3, 0, 5, 0.f) < inlay);
+
+    // Opaque draws are grouped by texture, then by style and drawn front to back
+    REQUIRE(DrawList::sortKey(Blending::opaque, 0, 1, 5, 0.f) <
+            DrawList::sortKey(Blending::opaque, 0, 2, 1, 0.f));
+    REQUIRE(DrawList::sortKey(Blending::opaque, 0, 1, 1, 1.f) <
+            DrawList::sortKey(Blending::opaque, 0, 1, 2, 0.f));
+    REQUIRE(DrawList::sortKey(Blending::opaque, 0, 1, 1, 0.2f) <
+            DrawList::sortKey(Blending::opaque, 0, 1, 1, 0.8f));
+
+    // Blend order does not matter for opaque draws
+    REQUIRE(DrawList::sortKey(Blending::opaque, -5, 1, 1, 0.f) ==
+            DrawList::sortKey(Blending::opaque, 5, 1, 1, 0.f));
+
+    // Texture and depth do not change the order of blended draws
+    REQUIRE(DrawList::sortKey(Blending::overlay, 0, 7, 1, 1.f) <
+            DrawList::sortKey(Blending::overlay, 0, 0, 2, 0.f));
+}
+
+TEST_CASE( "Draw list orders opaque tiles by depth and keeps the order of blended styles", "[Core][DrawList]" ) {
+
+    View view(256, 256);
+    view.setZoom(2);
+    view.setPosition(0, 0);
+    view.setPitch(0.8f);
+    view.update();
+
+    std::vector<std::unique_ptr<Style>> styles;
+    styles.push_back(std::make_unique<PolygonStyle>("opaque"));
+    styles.push_back(std::make_unique<PolygonStyle>("overlay", Blending::overlay));
+    styles.push_back(std::make_unique<PolygonStyle>("empty"));
+    for (size_t i = 0; i < styles.size(); i++) {
+        styles[i]->setID(i);
+    }
+
+    // The tilted view looks north, tiles in the south are closer
+    std::vector<std::shared_ptr<Tile>> tiles;
+    tiles.push_back(std::make_shared<Tile>(TileID{1, 1, 2}));
+    tiles.push_back(std::make_shared<Tile>(TileID{1, 2, 2}));
+    tiles.push_back(std::make_shared<Tile>(TileID{2, 2, 2}));
+
+    for (auto& tile : tiles) {
+        tile->update(0, view);
+        tile->setMesh(*styles[0], std::make_unique<DrawListTestMesh>());
+        tile->setMesh(*styles[1], std::make_unique<DrawListTestMesh>());
+    }
+
+    DrawList drawList;
+    drawList.build(styles, tiles);
+
+    auto& items = drawList.items();
+
+    // Three tiles of two styles and one item for the markers of each style
+    REQUIRE(items.size() == 9);
+
+    REQUIRE(items[0].style == 0);
+    REQUIRE(items[0].tile != 0);
+    REQUIRE(items[1].style == 0);
+    REQUIRE(items[1].tile != 0);
+    REQUIRE(items[2].style == 0);
+    REQUIRE(items[2].tile == 0);
+    REQUIRE(items[3].style == 0);
+    REQUIRE(items[3].tile == -1);
+
+    // Styles without tile meshes are drawn for their markers
+    REQUIRE(items[4].style == 2);
+    REQUIRE(items[4].tile == -1);
+
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(items[5 + i].style == 1);
+        REQUIRE(items[5 + i].tile == i);
+    }
+    REQUIRE(items[8].style == 1);
+    REQUIRE(items[8].tile == -1);
+}
+
+TEST_CASE( "RenderState counts state changes of a frame", "[Core][DrawList]" ) {
+    RenderState rs;
+
+    rs.shaderProgram(1);
+    rs.shaderProgram(1);
+    rs.shaderProgram(2);
+    rs.texture(1, 0, GL_TEXTURE_2D);
+    rs.texture(1, 0, GL_TEXTURE_2D);
+    rs.blending(GL_TRUE);
+    rs.blending(GL_TRUE);
+    rs.depthTest(GL_FALSE);
+
+    auto& stats = rs.frameStats();
+    REQUIRE(stats.programBinds == 2);
+    REQUIRE(stats.textureBinds == 1);
+    REQUIRE(stats.stateChanges == 2);
+    REQUIRE(stats.redundantStates == 3);
+
+    rs.resetFrameStats();
+    rs.shaderProgram(2);
+    REQUIRE(rs.frameStats().programBinds == 0);
+    REQUIRE(rs.frameStats().redundantStates == 1);
+}
@@ -130,6 +130,39 @@ TEST_CASE("DrawRule correctly merges with another DrawRule", TAGS) {
         CHECK(*mergedRule0.name == "draw_group_0");
         CHECK(*mergedRule1.name == "draw_group_1");
     }
+
+    SECTION("merged rules list the keys of their active parameters") {
+        DrawRuleMergeSet mergeSet;
+        mergeSet.mergeRules(layer_a);
+        mergeSet.mergeRules(layer_b);
+
+        auto& mergedRule = mergeSet.matchedRules()[0];
+
+        auto activeKeys = [&]() {
+            std::vector<StyleParamKey> keys;
+            for (size_t n = 0; n < mergedRule.activeCount; n++) {
+                auto key = mergedRule.activeKeys[n];
+                CHECK(mergedRule.active[key]);
+                keys.push_back(static_cast<StyleParamKey>(key));
+            }
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        };
+
+        REQUIRE(mergedRule.active.count() == 4);
+        CHECK(activeKeys() == std::vector<StyleParamKey>{ StyleParamKey::color, StyleParamKey::join,
+                                                          StyleParamKey::order, StyleParamKey::style });
+
+        mergedRule.deactivate(static_cast<uint8_t>(StyleParamKey::join));
+        CHECK(!mergedRule.contains(StyleParamKey::join));
+        CHECK(activeKeys() == std::vector<StyleParamKey>{ StyleParamKey::color, StyleParamKey::order,
+                                                          StyleParamKey::style });
+
+        mergedRule.activate(static_cast<uint8_t>(StyleParamKey::join));
+        mergedRule.activate(static_cast<uint8_t>(StyleParamKey::join));
+        CHECK(mergedRule.contains(StyleParamKey::join));
+        CHECK(activeKeys().size() == 4);
+    }
 }
 
 }
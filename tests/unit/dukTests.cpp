@@ -375,3 +375,101 @@ TEST_CASE( "Test evalFunction explicit", "[Duktape][evalFunction]") {
     }
 
 }
+
+TEST_CASE("Test JS function results are cached by the properties they read", "[Duktape][evalStyle]") {
+    StyleContext ctx;
+    ctx.setZoom(10);
+    ctx.setSceneGlobals(YAML::Load("{ count: 0 }"));
+
+    REQUIRE(ctx.setFunctions({
+        // Cacheable, reads 'kind' and $geometry
+        R"(function() { var k = feature.kind; return k === 'park' && $geometry === 'polygon' ? 1 : 2; })",
+        // Impure: keeps state in the scene globals
+        R"(function() { var c = global.count || 0; global.count = c + 1; return c; })",
+        // May read the feature through a function from the scene globals
+        R"(function() { var k = feature.kind; return global.rank(k); })",
+        // Reads properties by computed name
+        R"(function() { var k = 'kind'; return feature[k]; })",
+    }));
+
+    CHECK(ctx.functionCacheSize(0) == 0);
+    CHECK(ctx.functionCacheSize(1) == -1);
+    CHECK(ctx.functionCacheSize(2) == -1);
+    CHECK(ctx.functionCacheSize(3) == -1);
+
+    Feature park, parkLine, water;
+    park.props.set("kind", "park");
+    park.props.set("name", "a");
+    parkLine.props.set("kind", "park");
+    parkLine.geometryType = GeometryType::lines;
+    water.props.set("kind", "water");
+
+    StyleParam::Value value;
+    for (auto* feature : { &park, &parkLine, &water, &park, &water }) {
+        ctx.setFeature(*feature);
+        REQUIRE(ctx.evalStyle(0, StyleParamKey::order, value));
+        CHECK(value.get<uint32_t>() == (feature == &park ? 1 : 2));
+    }
+    CHECK(ctx.functionCacheSize(0) == 3);
+
+    ctx.clearFunctionCache();
+    CHECK(ctx.functionCacheSize(0) == 0);
+
+    ctx.setFeature(park);
+    REQUIRE(ctx.evalStyle(1, StyleParamKey::order, value));
+    REQUIRE(ctx.evalStyle(1, StyleParamKey::order, value));
+    CHECK(value.get<uint32_t>() == 1);
+}
+
+TEST_CASE("Test functions loaded from bytecode", "[Duktape][evalStyle]") {
+    std::vector<std::string> functions = {
+        R"(function() { var w = feature.width; return w * 2 + global.offset; })",
+        R"(function() { return [2, 0, 2, 2].map(function(c) { return c / 2; }); })",
+        R"(function() { return feature.kind === 'park'; })",
+    };
+
+    std::vector<std::vector<uint8_t>> bytecode;
+    CHECK(StyleContext::compileFunctions(functions, bytecode) > 0);
+    REQUIRE(bytecode.size() == functions.size());
+
+    // Bytecode is preferred, functions without bytecode are compiled from source
+    bytecode[2].clear();
+
+    Feature feature;
+    feature.props.set("width", 3);
+    feature.props.set("kind", "park");
+
+    StyleContext ctx;
+    ctx.setZoom(10);
+    ctx.setSceneGlobals(YAML::Load("{ offset: 1 }"));
+    REQUIRE(ctx.setFunctions(functions, bytecode));
+    ctx.setFeature(feature);
+
+    StyleParam::Value value;
+    REQUIRE(ctx.evalStyle(0, StyleParamKey::width, value));
+    CHECK(value.get<StyleParam::Width>().value == 7);
+
+    REQUIRE(ctx.evalStyle(1, StyleParamKey::color, value));
+    CHECK(value.get<uint32_t>() == 0xffff00ff);
+
+    CHECK(ctx.evalFilter(2) == true);
+
+    // Truncated, corrupted or invalid bytecode falls back to the source
+    bytecode[0].resize(bytecode[0].size() / 2);
+    bytecode[1].back()++;
+    bytecode[2] = { 1, 2, 3 };
+
+    StyleContext ctx2;
+    ctx2.setZoom(10);
+    ctx2.setSceneGlobals(YAML::Load("{ offset: 1 }"));
+    REQUIRE(ctx2.setFunctions(functions, bytecode));
+    ctx2.setFeature(feature);
+
+    REQUIRE(ctx2.evalStyle(0, StyleParamKey::width, value));
+    CHECK(value.get<StyleParam::Width>().value == 7);
+
+    REQUIRE(ctx2.evalStyle(1, StyleParamKey::color, value));
+    CHECK(value.get<uint32_t>() == 0xffff00ff);
+
+    CHECK(ctx2.evalFilter(2) == true);
+}
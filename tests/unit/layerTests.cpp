@@ -4,6 +4,8 @@
 #include "data/tileData.h"
 #include "scene/styleContext.h"
 
+#include <algorithm>
+
 using namespace Tangram;
 
 namespace {
@@ -144,4 +146,129 @@ TEST_CASE("SceneLayer exclusive and priority", TAGS) {
     }
 }
 
+TEST_CASE("SceneLayer indexed sublayer matching", TAGS) {
+    // Siblings filtering on 'kind' are matched through a SublayerIndex
+
+    int ruleId = 0;
+    auto kindLayer = [&](std::string name, std::vector<Value> kinds, bool exclusive = false) {
+        SceneLayer::Options options;
+        options.exclusive = exclusive;
+        DrawRuleData rule = {name, ruleId++, {{StyleParamKey::order, name}}};
+        return SceneLayer{name, Filter::MatchEquality("kind", kinds), {rule}, {}, options};
+    };
+
+    const DrawRuleData ruleAny = {"any", 10, {{StyleParamKey::order, "any"}}};
+    const SceneLayer layerAny = {"any", Filter(), {ruleAny}, {}, SceneLayer::Options()};
+
+    const DrawRuleData ruleBig = {"big", 11, {{StyleParamKey::order, "big"}}};
+    const SceneLayer layerBig = {"big", Filter::MatchAll({ Filter::MatchEquality("kind", {Value("c")}),
+                                                          Filter::MatchExistence("big", true) }),
+                                 {ruleBig}, {}, SceneLayer::Options()};
+
+    const SceneLayer layer = {"layer", Filter(), {}, {
+            kindLayer("a", {Value("a")}),
+            kindLayer("b", {Value("b")}),
+            kindLayer("c", {Value("c")}),
+            kindLayer("d", {Value("d")}),
+            kindLayer("ab", {Value("a"), Value("b")}, true),
+            layerAny, layerBig }, SceneLayer::Options()};
+
+    REQUIRE(layer.sublayerIndex() != nullptr);
+    REQUIRE(layer.sublayerIndex()->key == "kind");
+
+    StyleContext context;
+    DrawRuleMergeSet ruleSet;
+
+    auto matches = [&](const Feature& feature) {
+        ruleSet.match(feature, layer, context);
+        std::vector<std::string> names;
+        for (auto& rule : ruleSet.matchedRules()) { names.push_back(*rule.name); }
+        std::sort(names.begin(), names.end());
+        return names;
+    };
+
+    Feature feature;
+
+    SECTION("exclusive keyed sublayer stops matching") {
+        feature.props.set("kind", "a");
+        REQUIRE(matches(feature) == std::vector<std::string>{"ab"});
+    }
+    SECTION("keyed and unkeyed sublayers match") {
+        feature.props.set("kind", "c");
+        REQUIRE(matches(feature) == (std::vector<std::string>{"any", "c"}));
+
+        feature.props.set("big", 1);
+        REQUIRE(matches(feature) == (std::vector<std::string>{"any", "big", "c"}));
+    }
+    SECTION("other values only match unkeyed sublayers") {
+        feature.props.set("kind", 1);
+        REQUIRE(matches(feature) == std::vector<std::string>{"any"});
+    }
+}
+
+TEST_CASE("SceneLayer specialized to a zoom level", TAGS) {
+    // layer:
+    //   high:  { filter: { $zoom: { min: 14 } } }
+    //   low:   { filter: { $zoom: { max: 14 } }, exclusive: true }
+    //   park:  { filter: { all: [{ $zoom: { min: 10 } }, { kind: park }] } }
+    //   empty: { filter: { kind: water } }
+
+    auto rule = [](std::string name, int id) {
+        return DrawRuleData{name, id, {{StyleParamKey::order, name}}};
+    };
+
+    SceneLayer::Options exclusive;
+    exclusive.exclusive = true;
+
+    const SceneLayer layerHigh = {"high", Filter::MatchRange("$zoom", 14, INFINITY, false),
+                                  {rule("high", 0)}, {}, SceneLayer::Options()};
+    const SceneLayer layerLow = {"low", Filter::MatchRange("$zoom", -INFINITY, 14, false),
+                                 {rule("low", 1)}, {}, exclusive};
+    const SceneLayer layerPark = {"park", Filter::MatchAll({ Filter::MatchRange("$zoom", 10, INFINITY, false),
+                                                             Filter::MatchEquality("kind", {Value("park")}) }),
+                                  {rule("park", 2)}, {}, SceneLayer::Options()};
+    const SceneLayer layerEmpty = {"empty", Filter::MatchEquality("kind", {Value("water")}),
+                                   {}, {}, SceneLayer::Options()};
+
+    const SceneLayer layer = {"layer", Filter(), {},
+                              {layerHigh, layerLow, layerPark, layerEmpty}, SceneLayer::Options()};
+
+    SECTION("exclusive layer matching at all features hides its siblings") {
+        auto specialized = layer.specializeZoom(12);
+        REQUIRE(specialized);
+        REQUIRE(specialized->sublayers().size() == 1);
+        CHECK(specialized->sublayers()[0].name() == "low");
+        CHECK(!specialized->sublayers()[0].filter().isValid());
+    }
+
+    SECTION("zoom filters are folded and dead sublayers removed") {
+        auto specialized = layer.specializeZoom(15);
+        REQUIRE(specialized);
+        REQUIRE(specialized->sublayers().size() == 2);
+        CHECK(specialized->sublayers()[0].name() == "park");
+        CHECK(specialized->sublayers()[0].filter().data.is<Filter::Equality>());
+        CHECK(specialized->sublayers()[1].name() == "high");
+        CHECK(specialized->sublayers()[1].nameHash() == layerHigh.nameHash());
+        CHECK(layerHigh.nameHash() != layerLow.nameHash());
+
+        StyleContext context;
+        context.setZoom(15);
+        DrawRuleMergeSet ruleSet;
+
+        Feature feature;
+        feature.props.set("kind", "park");
+
+        ruleSet.match(feature, *specialized, context);
+        auto& matches = ruleSet.matchedRules();
+        REQUIRE(matches.size() == 2);
+    }
+
+    SECTION("layers that cannot match are dropped") {
+        const SceneLayer layerMax = {"max", Filter::MatchRange("$zoom", -INFINITY, 5, false),
+                                     {}, {layer}, SceneLayer::Options()};
+        CHECK(!layerMax.specializeZoom(5));
+        CHECK(layerMax.specializeZoom(4));
+    }
+}
+
 } // namespace
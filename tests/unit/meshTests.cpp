@@ -2,6 +2,10 @@
 
 #include <iostream>
 #include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl_mock.h"
+#include "tile/tileID.h"
 
 using namespace Tangram;
 
@@ -170,3 +174,215 @@ TEST_CASE( "Check overflow", "[Core][TypedMesh]" ) {
 
     checkBounds(mesh);
 }
+
+TEST_CASE( "Compile takes the buffers of moved MeshData", "[Core][TypedMesh]" ) {
+    struct BufferMesh : public TestMesh {
+        using TestMesh::TestMesh;
+        const GLbyte* vertexData() const { return m_glVertexData; }
+        const GLushort* indexData() const { return reinterpret_cast<GLushort*>(m_glIndexData); }
+    };
+
+    MeshData<Vertex> meshData;
+    for (int feature = 0; feature < 2; ++feature) {
+        meshData.vertices.insert(meshData.vertices.end(), 3, {0,0,0,0});
+        meshData.indices.insert(meshData.indices.end(), { 0, 1, 2 });
+        meshData.offsets.emplace_back(3, 3);
+    }
+    const Vertex* vertices = meshData.vertices.data();
+    const uint16_t* indices = meshData.indices.data();
+
+    auto mesh = std::make_unique<BufferMesh>(layout, GL_TRIANGLES);
+    mesh->compile(std::move(meshData));
+
+    REQUIRE(mesh->numVertices() == 6);
+    REQUIRE(mesh->numIndices() == 6);
+    REQUIRE(mesh->vertexData() == reinterpret_cast<const GLbyte*>(vertices));
+    REQUIRE(mesh->indexData() == indices);
+
+    // Indices of the second feature are shifted by the vertices of the first
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE(mesh->indexData()[i] == i);
+    }
+
+    // Meshes of the other tests have filled the pool
+    while (MeshBufferPool<Vertex>::size() > 0) {
+        std::vector<Vertex> buffer;
+        MeshBufferPool<Vertex>::acquire(buffer);
+    }
+
+    // The buffers return to the pool and are reused on clear()
+    mesh.reset();
+    REQUIRE(MeshBufferPool<Vertex>::size() == 1);
+
+    meshData.clear();
+    REQUIRE(meshData.vertices.data() == vertices);
+    REQUIRE(meshData.vertices.empty());
+    REQUIRE(MeshBufferPool<Vertex>::size() == 0);
+}
+
+// Two meshes of four features with 20000 vertices each
+static std::vector<MeshData<Vertex>> largeMeshData() {
+    std::vector<MeshData<Vertex>> meshes(2);
+    for (auto& meshData : meshes) {
+        for (int feature = 0; feature < 4; ++feature) {
+            meshData.vertices.insert(meshData.vertices.end(), 20000, {0,0,0,0});
+            meshData.indices.insert(meshData.indices.end(), { 0, 1, 19999 });
+            meshData.offsets.emplace_back(3, 20000);
+        }
+    }
+    return meshes;
+}
+
+TEST_CASE( "Compile splits indices into batches of 16 bit range", "[Core][TypedMesh]" ) {
+    auto meshes = largeMeshData();
+
+    struct BatchMesh : public TestMesh {
+        using TestMesh::TestMesh;
+        const GLushort* indexData() const { return reinterpret_cast<GLushort*>(m_glIndexData); }
+        size_t numBatches() const { return m_vertexOffsets.size(); }
+    };
+
+    BatchMesh mesh(layout, GL_TRIANGLES);
+    mesh.compile(std::move(meshes));
+
+    REQUIRE(mesh.numVertices() == 160000);
+    REQUIRE(mesh.numIndices() == 24);
+    // Three features fit into one batch
+    REQUIRE(mesh.numBatches() == 3);
+
+    std::vector<GLushort> expected = { 0, 1, 19999, 20000, 20001, 39999, 40000, 40001, 59999 };
+    for (size_t i = 0; i < 24; ++i) {
+        REQUIRE(mesh.indexData()[i] == expected[i % 9]);
+    }
+}
+
+TEST_CASE( "Meshes exceeding 16 bit indices are drawn with one call when 32 bit indices are supported", "[Core][TypedMesh]" ) {
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setShaderSource("vertex", "fragment");
+
+    // Restore the hardware flag also when a REQUIRE fails
+    struct RestoreElementIndexUint {
+        bool value = Hardware::supportsElementIndexUint;
+        ~RestoreElementIndexUint() { Hardware::supportsElementIndexUint = value; }
+    } restoreElementIndexUint;
+
+    Hardware::supportsElementIndexUint = false;
+    {
+        TestMesh mesh(layout, GL_TRIANGLES);
+        mesh.compile(largeMeshData());
+
+        GLMock::counters = {};
+        REQUIRE(mesh.draw(rs, shader, false));
+        REQUIRE(GLMock::counters.drawElements == 3);
+        REQUIRE(GLMock::counters.drawElementsUInt == 0);
+    }
+
+    Hardware::supportsElementIndexUint = true;
+    {
+        TestMesh mesh(layout, GL_TRIANGLES);
+        mesh.compile(largeMeshData());
+
+        GLMock::counters = {};
+        REQUIRE(mesh.draw(rs, shader, false));
+        REQUIRE(GLMock::counters.drawCalls() == 1);
+        REQUIRE(GLMock::counters.drawElementsUInt == 1);
+        REQUIRE(mesh.bufferSize() == 160000 * layout->getStride() + 24 * sizeof(GLuint));
+    }
+    {
+        // Meshes within the 16 bit range keep 16 bit indices
+        TestMesh mesh(layout, GL_TRIANGLES);
+        mesh.compile(MeshData<Vertex>({ 0, 1, 2 }, { {0,0,0,0}, {0,0,0,0}, {0,0,0,0} }));
+
+        GLMock::counters = {};
+        REQUIRE(mesh.draw(rs, shader, false));
+        REQUIRE(GLMock::counters.drawElements == 1);
+        REQUIRE(GLMock::counters.drawElementsUInt == 0);
+        REQUIRE(mesh.bufferSize() == 3 * layout->getStride() + 3 * sizeof(GLushort));
+    }
+}
+
+struct TileVertex {
+    int16_t x;
+    int16_t y;
+};
+
+TEST_CASE( "Meshes of neighboring tiles are merged into one mesh", "[Core][TypedMesh]" ) {
+    auto tileLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_SHORT, false, 0},
+    }));
+    const float positionScale = 8192;
+
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setShaderSource("vertex", "fragment");
+
+    std::vector<std::unique_ptr<Mesh<TileVertex>>> meshes;
+    std::vector<StyledMesh::MergeItem> items;
+
+    // Offsets of the tiles of a 2x2 block to its anchor tile, the lower left
+    // one, as computed by Style. Tile y grows southwards, position y northwards.
+    const TileID tiles[] = { {4, 7, 3}, {5, 7, 3}, {4, 6, 3}, {5, 6, 3} };
+    const glm::ivec2 anchor{ tiles[0].x & ~1, tiles[0].y | 1 };
+
+    for (auto& tile : tiles) {
+        auto mesh = std::make_unique<Mesh<TileVertex>>(tileLayout, GL_TRIANGLES);
+        mesh->compile(MeshData<TileVertex>({ 0, 1, 2 }, { {0, 0}, {8192, 0}, {0, 8192} }));
+        mesh->retainData(positionScale);
+        items.push_back({ mesh.get(), { tile.x - anchor.x, anchor.y - tile.y } });
+        meshes.push_back(std::move(mesh));
+    }
+
+    GLMock::counters = {};
+    for (auto& mesh : meshes) {
+        REQUIRE(mesh->draw(rs, shader, false));
+    }
+    REQUIRE(GLMock::counters.drawElements == 4);
+
+    // Retained data can be merged after upload
+    auto merged = meshes[0]->merge(items);
+    REQUIRE(merged);
+    REQUIRE(merged->bufferSize() == 4 * meshes[0]->bufferSize());
+
+    GLMock::counters = {};
+    REQUIRE(merged->draw(rs, shader, false));
+    REQUIRE(GLMock::counters.drawElements == 1);
+
+    // Positions are shifted by the offset of their tile in tile units
+    auto& uploaded = GLMock::counters.arrayBufferData;
+    REQUIRE(uploaded.size() == 12 * sizeof(TileVertex));
+    auto* positions = reinterpret_cast<const TileVertex*>(uploaded.data());
+
+    const TileVertex expected[] = {
+        {0, 0}, {8192, 0}, {0, 8192},               // 4/7, the anchor
+        {8192, 0}, {16384, 0}, {8192, 8192},        // 5/7
+        {0, 8192}, {8192, 8192}, {0, 16384},        // 4/6
+        {8192, 8192}, {16384, 8192}, {8192, 16384}, // 5/6
+    };
+    for (int i = 0; i < 12; i++) {
+        CHECK(positions[i].x == expected[i].x);
+        CHECK(positions[i].y == expected[i].y);
+    }
+
+    // Only the merged mesh is kept on the GPU, tile meshes are uploaded again when drawn
+    meshes[1]->releaseResident();
+    REQUIRE_FALSE(meshes[1]->isResident());
+    rs.flushResourceDeletion();
+    REQUIRE(rs.vertexArena(tileLayout->getStride()).usedBytes() == 3 * 16 + 48);
+
+    REQUIRE(meshes[1]->draw(rs, shader, false));
+    REQUIRE(meshes[1]->isResident());
+    REQUIRE(meshes[1]->merge(items));
+
+    // Shifted positions exceeding the 16 bit range
+    items[3].offset = { 3, 0 };
+    REQUIRE_FALSE(meshes[0]->merge(items));
+
+    // Meshes without retained data
+    Mesh<TileVertex> mesh(tileLayout, GL_TRIANGLES);
+    mesh.compile(MeshData<TileVertex>({ 0, 1, 2 }, { {0, 0}, {8192, 0}, {0, 8192} }));
+    REQUIRE(mesh.draw(rs, shader, false));
+
+    items[3] = { &mesh, { 1, 1 } };
+    REQUIRE_FALSE(meshes[0]->merge(items));
+}
@@ -0,0 +1,115 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "scene/nativeFunction.h"
+#include "scene/styleContext.h"
+
+using namespace Tangram;
+
+using Type = NativeFunction::Result::Type;
+
+static NativeFunction::Result evalNative(const std::string& _source, const Feature& _feature,
+                                         StyleContext& _ctx) {
+    NativeFunction function;
+    NativeFunction::Result result;
+    REQUIRE(function.compile(_source));
+    REQUIRE(function.eval(_feature, _ctx, result));
+    return result;
+}
+
+TEST_CASE("NativeFunction compiles simple expression functions only", "[NativeFunction]") {
+    NativeFunction function;
+
+    CHECK(function.compile("function() { return feature.height > 20 && $zoom > 15; }"));
+    CHECK(function.compile("function () {return feature['name:en'] || feature.name}"));
+    CHECK(function.compile("function() { return $geometry === 'line' ? 2 : -(feature.w * .5e1); }"));
+
+    // Statements, calls, member access on values and globals are left to the JSContext
+    CHECK_FALSE(function.compile("function() { var a = feature.a; return a; }"));
+    CHECK_FALSE(function.compile("function() { return Math.max(feature.a, 1); }"));
+    CHECK_FALSE(function.compile("function() { return feature.name.length; }"));
+    CHECK_FALSE(function.compile("function() { return global.color; }"));
+    CHECK_FALSE(function.compile("function() { return feature.a & 1; }"));
+    CHECK_FALSE(function.compile("function() { return 0x10; }"));
+    CHECK_FALSE(function.compile("function() { return\n feature.a; }"));
+    CHECK_FALSE(function.compile("function() { return [1, 2]; }"));
+}
+
+TEST_CASE("NativeFunction evaluates with JS semantics", "[NativeFunction]") {
+    Feature feature;
+    feature.props.set("height", 30);
+    feature.props.set("kind", "park");
+    feature.props.set("number", "42");
+    feature.props.set("empty", "");
+
+    StyleContext ctx;
+    ctx.setZoom(16);
+    ctx.setFeature(feature);
+
+    auto result = evalNative("function() { return feature.height > 20 && $zoom > 15; }", feature, ctx);
+    CHECK(result.type == Type::boolean);
+    CHECK(result.boolean == true);
+
+    // Logical operators return their operands
+    result = evalNative("function() { return feature.missing || feature.kind; }", feature, ctx);
+    CHECK(result.type == Type::string);
+    CHECK(result.string == "park");
+
+    result = evalNative("function() { return feature.empty && feature.kind; }", feature, ctx);
+    CHECK(result.type == Type::string);
+    CHECK(result.string == "");
+
+    result = evalNative("function() { return feature.missing; }", feature, ctx);
+    CHECK(result.type == Type::undefined);
+
+    // Loose and strict equality
+    CHECK(evalNative("function() { return feature.number == 42; }", feature, ctx).boolean == true);
+    CHECK(evalNative("function() { return feature.number === 42; }", feature, ctx).boolean == false);
+    CHECK(evalNative("function() { return feature.missing == null; }", feature, ctx).boolean == true);
+    CHECK(evalNative("function() { return feature.missing === null; }", feature, ctx).boolean == false);
+
+    // String concatenation and number conversion
+    result = evalNative("function() { return feature.kind + '-' + feature.height / 4; }", feature, ctx);
+    CHECK(result.string == "park-7.5");
+
+    result = evalNative("function() { return feature.number * 2 + 1; }", feature, ctx);
+    CHECK(result.type == Type::number);
+    CHECK(result.number == 85);
+
+    result = evalNative("function() { return feature.kind * 2; }", feature, ctx);
+    CHECK(std::isnan(result.number));
+
+    // Comparisons with NaN are false
+    CHECK(evalNative("function() { return feature.missing < 1 || feature.missing >= 1; }",
+                     feature, ctx).boolean == false);
+
+    result = evalNative("function() { return $geometry == 'polygon' ? feature.height % 7 : 0; }",
+                        feature, ctx);
+    CHECK(result.number == 2);
+}
+
+TEST_CASE("StyleContext evaluates native and JS functions alike", "[NativeFunction][Duktape]") {
+    Feature feature;
+    feature.props.set("sort_key", 2);
+    feature.props.set("kind", "park");
+
+    StyleContext ctx;
+    ctx.setZoom(10);
+    ctx.setFeature(feature);
+
+    // Same expression, once in the native subset and once using a local variable
+    REQUIRE(ctx.setFunctions({
+        R"(function() { return feature.kind === 'park' ? feature.sort_key + 5 : 0; })",
+        R"(function() { var k = feature.kind; return k === 'park' ? feature.sort_key + 5 : 0; })"
+    }));
+
+    StyleParam::Value native, js;
+    REQUIRE(ctx.evalStyle(0, StyleParamKey::order, native));
+    REQUIRE(ctx.evalStyle(1, StyleParamKey::order, js));
+    REQUIRE(native.is<uint32_t>());
+    REQUIRE(js.is<uint32_t>());
+    CHECK(native.get<uint32_t>() == 7);
+    CHECK(js.get<uint32_t>() == 7);
+
+    CHECK(ctx.evalFilter(0) == ctx.evalFilter(1));
+}
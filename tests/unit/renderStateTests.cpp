@@ -0,0 +1,206 @@
+#include "catch.hpp"
+
+#include "gl/hardware.h"
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl/texture.h"
+#include "gl_mock.h"
+#include "map.h"
+#include "mockPlatform.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+static std::unique_ptr<Texture> newTexture(RenderState& rs, int width, int height) {
+    std::vector<GLubyte> pixels(width * height * 4);
+    auto texture = std::make_unique<Texture>(TextureOptions());
+    texture->setPixelData(width, height, 4, pixels.data(), pixels.size());
+    texture->bind(rs, 0);
+    return texture;
+}
+
+TEST_CASE("Released textures are reused for textures of the same size", "[Core][RenderState]") {
+    RenderState rs;
+    Hardware::maxTextureSize = 1024;
+
+    GLMock::counters = {};
+    auto a = newTexture(rs, 256, 256);
+    GLuint handle = a->glHandle();
+    a.reset();
+
+    auto b = newTexture(rs, 256, 256);
+    REQUIRE(b->glHandle() == handle);
+    REQUIRE(GLMock::counters.genTextures == 1);
+    REQUIRE(GLMock::counters.texImage2D == 1);
+    REQUIRE(GLMock::counters.texSubImage2D == 1);
+
+    // Textures of other sizes get their own storage
+    auto c = newTexture(rs, 128, 256);
+    REQUIRE(c->glHandle() != handle);
+    REQUIRE(GLMock::counters.genTextures == 2);
+
+    auto stats = rs.poolStats();
+    REQUIRE(stats.textureHits == 1);
+    REQUIRE(stats.textureMisses == 2);
+
+    // Full pools queue the oldest texture for deletion
+    std::vector<std::unique_ptr<Texture>> textures;
+    for (size_t i = 0; i < RenderState::MAX_POOLED_TEXTURES + 1; i++) {
+        textures.push_back(newTexture(rs, 64, 64));
+    }
+    textures.clear();
+    REQUIRE(rs.pendingDeletions() == 1);
+
+    rs.flushResourceDeletion();
+    REQUIRE(GLMock::counters.deleteTextures == 1);
+    REQUIRE(rs.pendingDeletions() == 0);
+}
+
+TEST_CASE("Texture pools are limited by texture size and bytes", "[Core][RenderState]") {
+    RenderState rs;
+    Hardware::maxTextureSize = 4096;
+
+    // 1024x1024 RGBA textures fill a quarter of the pool
+    const int size = 1024;
+    REQUIRE(size_t(size * size * 4) == RenderState::MAX_POOLED_TEXTURE_SIZE);
+    REQUIRE(4 * RenderState::MAX_POOLED_TEXTURE_SIZE == RenderState::MAX_POOLED_TEXTURE_BYTES);
+
+    // Larger textures are deleted
+    newTexture(rs, 2 * size, size).reset();
+    REQUIRE(rs.pendingDeletions() == 1);
+    rs.flushResourceDeletion();
+
+    std::vector<std::unique_ptr<Texture>> textures;
+    for (int i = 0; i < 5; i++) {
+        textures.push_back(newTexture(rs, size, size));
+    }
+    GLuint first = textures[0]->glHandle();
+    textures.clear();
+
+    // The oldest texture is deleted to stay within the byte budget
+    REQUIRE(rs.pendingDeletions() == 1);
+    REQUIRE(rs.acquireTexture(size, size, GL_RGBA) != first);
+    REQUIRE(rs.acquireTexture(size, size, GL_RGBA) != 0);
+}
+
+TEST_CASE("Clearing the pools queues pooled resources for deletion", "[Core][RenderState]") {
+    RenderState rs;
+
+    rs.releaseTexture(1, 64, 64, GL_RGBA, 64 * 64 * 4);
+    rs.releaseBuffer(2, GL_ARRAY_BUFFER, 1000);
+    REQUIRE(rs.pendingDeletions() == 0);
+
+    rs.clearResourcePools();
+    REQUIRE(rs.pendingDeletions() == 2);
+    REQUIRE(rs.acquireTexture(64, 64, GL_RGBA) == 0);
+    REQUIRE(rs.acquireBuffer(GL_ARRAY_BUFFER, 1000) != 2);
+
+    GLMock::counters = {};
+    rs.flushResourceDeletion();
+    REQUIRE(GLMock::counters.deleteTextures == 1);
+    REQUIRE(GLMock::counters.deleteBuffers == 1);
+}
+
+struct PoolVertex {
+    float x, y;
+};
+
+TEST_CASE("Buffers of dynamic meshes are reused", "[Core][RenderState]") {
+    auto layout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+    }));
+
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setShaderSource("vertex", "fragment");
+
+    auto newMesh = [&](size_t vertices) {
+        auto mesh = std::make_unique<Mesh<PoolVertex>>(layout, GL_TRIANGLES, GL_DYNAMIC_DRAW);
+        std::vector<uint16_t> indices(vertices);
+        std::vector<PoolVertex> data(vertices);
+        mesh->compile(MeshData<PoolVertex>(std::move(indices), std::move(data)));
+        mesh->draw(rs, shader, false);
+        return mesh;
+    };
+
+    GLMock::counters = {};
+    newMesh(100).reset();
+    REQUIRE(GLMock::counters.genBuffers == 2);
+
+    // Buffers of about the same size are reused
+    auto mesh = newMesh(90);
+    REQUIRE(GLMock::counters.genBuffers == 2);
+
+    // Other size classes need new buffers
+    newMesh(1000).reset();
+    REQUIRE(GLMock::counters.genBuffers == 4);
+
+    auto stats = rs.poolStats();
+    REQUIRE(stats.bufferHits == 2);
+    REQUIRE(stats.bufferMisses == 4);
+    REQUIRE(GLMock::counters.deleteBuffers == 0);
+}
+
+TEST_CASE("Resource deletion is spread over frames", "[Core][RenderState]") {
+    RenderState rs;
+
+    std::vector<GLuint> buffers(100);
+    for (size_t i = 0; i < buffers.size(); i++) { buffers[i] = i + 1; }
+
+    GLMock::counters = {};
+    rs.queueBufferDeletion(buffers.size(), buffers.data());
+
+    // Without time budget one chunk of deletions is done per frame
+    rs.flushResourceDeletion(0.f);
+    REQUIRE(GLMock::counters.deleteBuffers > 0);
+    REQUIRE(GLMock::counters.deleteBuffers < 100);
+    REQUIRE(rs.pendingDeletions() == 100 - GLMock::counters.deleteBuffers);
+
+    rs.flushResourceDeletion();
+    REQUIRE(GLMock::counters.deleteBuffers == 100);
+    REQUIRE(rs.pendingDeletions() == 0);
+}
+
+struct RenderRequestPlatform : public MockPlatform {
+    void requestRender() const override { renderRequests++; }
+    mutable int renderRequests = 0;
+};
+
+TEST_CASE("Map renders frames while resource deletions are pending", "[Core][RenderState]") {
+    auto platform = std::make_unique<RenderRequestPlatform>();
+    auto& renderRequests = platform->renderRequests;
+
+    Map map(std::move(platform));
+    auto& rs = map.getRenderState();
+
+    std::vector<GLuint> buffers(100);
+    for (size_t i = 0; i < buffers.size(); i++) { buffers[i] = i + 1; }
+    rs.queueBufferDeletion(buffers.size(), buffers.data());
+
+    // Deletions exceed the time budget of a frame
+    GLMock::deleteBuffersTime = std::chrono::milliseconds(2);
+
+    renderRequests = 0;
+    map.render();
+    REQUIRE(rs.pendingDeletions() > 0);
+    REQUIRE(renderRequests > 0);
+
+    while (rs.pendingDeletions() > 0) { map.render(); }
+    GLMock::deleteBuffersTime = {};
+
+    // No more frames are requested when all resources are deleted
+    renderRequests = 0;
+    map.render();
+    REQUIRE(renderRequests == 0);
+
+    // Memory warnings free the pooled resources on the next frame
+    rs.releaseBuffer(1, GL_ARRAY_BUFFER, 1000);
+    map.onMemoryWarning();
+    REQUIRE(rs.pendingDeletions() == 1);
+    REQUIRE(renderRequests > 0);
+
+    map.render();
+    REQUIRE(rs.pendingDeletions() == 0);
+}
@@ -0,0 +1,52 @@
+#include "catch.hpp"
+
+#include "tile/tileID.h"
+#include "util/simplify.h"
+
+using namespace Tangram;
+
+TEST_CASE("Simplifier removes vertices within tolerance", "[Simplify]") {
+    Simplifier simplifier;
+    simplifier.tolerance = 0.01f;
+
+    Line line = { {0.1f, 0.5f}, {0.3f, 0.505f}, {0.5f, 0.495f}, {0.7f, 0.5f}, {0.9f, 0.7f} };
+
+    const auto& result = simplifier.simplify(line);
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[0] == line[0]);
+    REQUIRE(result[1] == line[3]);
+    REQUIRE(result[2] == line[4]);
+}
+
+TEST_CASE("Simplifier keeps input when tolerance is zero", "[Simplify]") {
+    Simplifier simplifier;
+
+    Line line = { {0.1f, 0.5f}, {0.3f, 0.5f}, {0.5f, 0.5f} };
+
+    REQUIRE(&simplifier.simplify(line) == &line);
+}
+
+TEST_CASE("Simplifier keeps vertices on tile edges", "[Simplify]") {
+    Simplifier simplifier;
+    simplifier.tolerance = 0.1f;
+
+    // Ring clipped at the left tile edge
+    Polygon polygon = { { {0.f, 0.2f}, {0.f, 0.4f}, {0.f, 0.6f}, {0.5f, 0.61f},
+                          {0.9f, 0.6f}, {0.9f, 0.2f}, {0.5f, 0.21f}, {0.f, 0.2f} } };
+
+    const auto& result = simplifier.simplify(polygon);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].size() == 6);
+    REQUIRE(result[0][1] == polygon[0][1]);
+    REQUIRE(result[0][2] == polygon[0][2]);
+}
+
+TEST_CASE("Simplifier tolerance follows styling zoom", "[Simplify]") {
+    float tolerance = Simplifier::tileTolerance(1.f, TileID(0, 0, 10), 1.f);
+    float overzoomed = Simplifier::tileTolerance(1.f, TileID(0, 0, 10, 12), 1.f);
+    float scaled = Simplifier::tileTolerance(1.f, TileID(0, 0, 10), 2.f);
+
+    REQUIRE(tolerance == Approx(1.f / 256.f));
+    REQUIRE(overzoomed == Approx(tolerance / 4.f));
+    REQUIRE(scaled == Approx(tolerance / 2.f));
+}
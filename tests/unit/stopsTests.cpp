@@ -5,6 +5,8 @@
 #include "util/mapProjection.h"
 #include "glm/gtc/epsilon.hpp"
 
+#include <cmath>
+
 using namespace Tangram;
 
 Stops instance_color() {
@@ -95,6 +97,101 @@ TEST_CASE("Stops evaluate color values correctly at and between key frames", "[S
 
 }
 
+TEST_CASE("Color mix interpolates all channels", "[Stops]") {
+
+    Color x(0x80ff0000), y(0xff00ff40);
+
+    REQUIRE(Color::mix(x, y, 0).abgr == x.abgr);
+    REQUIRE(Color::mix(x, y, 1).abgr == y.abgr);
+    REQUIRE(Color::mix(x, y, -1).abgr == x.abgr);
+    REQUIRE(Color::mix(x, y, 0.5).abgr == 0xc0808020);
+
+}
+
+TEST_CASE("Color mix rounds like the interpolation of each channel", "[Stops]") {
+
+    auto mixChannel = [](uint8_t x, uint8_t y, float a) {
+        return std::lround(x * (1 - a) + y * a);
+    };
+
+    uint32_t colors[] = { 0x00000000, 0xffffffff, 0x80ff0000, 0xff00ff40, 0x12345678, 0xfedcba98 };
+    float weights[] = { 0.f, 0.1f, 0.25f, 0.3f, 0.5f, 0.7f, 0.99f, 1.f };
+
+    // Weights have 8 bit precision, channels are within one unit of the float result
+    for (Color x : colors) {
+        for (Color y : colors) {
+            for (float a : weights) {
+                Color c = Color::mix(x, y, a);
+                CHECK(std::abs(c.r - mixChannel(x.r, y.r, a)) <= 1);
+                CHECK(std::abs(c.g - mixChannel(x.g, y.g, a)) <= 1);
+                CHECK(std::abs(c.b - mixChannel(x.b, y.b, a)) <= 1);
+                CHECK(std::abs(c.a - mixChannel(x.a, y.a, a)) <= 1);
+            }
+        }
+    }
+
+    // Halfway values are rounded up, not truncated
+    REQUIRE(Color::mix(Color(0x00000000), Color(0xffffffff), 0.5).abgr == 0x80808080);
+    REQUIRE(Color::mix(Color(0xffffffff), Color(0x00000000), 0.5).abgr == 0x80808080);
+    REQUIRE(Color::mix(Color(0x00000000), Color(0x03030303), 0.5).abgr == 0x02020202);
+
+}
+
+TEST_CASE("Stops lookup tables give the same values as interpolation", "[Stops]") {
+
+    Stops colors = instance_color();
+    Stops widths(Stops::Widths(YAML::Load("[ [10, 0], [16, 4], [18, 20] ]"), {}));
+    Stops offsets({
+            Stops::Frame(1, glm::vec2(0.0)),
+            Stops::Frame(4.5, glm::vec2(1.0, 2.0))
+    });
+
+    Stops colorLookup = colors, widthLookup = widths, offsetLookup = offsets;
+    colorLookup.buildLookup(StyleParamKey::color);
+    widthLookup.buildLookup(StyleParamKey::width);
+    offsetLookup.buildLookup(StyleParamKey::offset);
+
+    REQUIRE(colorLookup.lookup.size() == 6);
+    REQUIRE(offsetLookup.lookup.size() == 6);
+
+    StyleParam::Value expected, value;
+    for (float zoom : { -1.f, 0.f, 1.f, 2.f, 2.5f, 4.f, 5.f, 9.f, 16.f, 16.7f, 17.f, 25.f }) {
+        Stops::eval(colors, StyleParamKey::color, zoom, expected);
+        Stops::eval(colorLookup, StyleParamKey::color, zoom, value);
+        CHECK(value.get<uint32_t>() == expected.get<uint32_t>());
+
+        Stops::eval(widths, StyleParamKey::width, zoom, expected);
+        Stops::eval(widthLookup, StyleParamKey::width, zoom, value);
+        CHECK(value.get<float>() == expected.get<float>());
+
+        Stops::eval(offsets, StyleParamKey::offset, zoom, expected);
+        Stops::eval(offsetLookup, StyleParamKey::offset, zoom, value);
+        CHECK(value.get<glm::vec2>() == expected.get<glm::vec2>());
+    }
+
+}
+
+TEST_CASE("Stops lookup tables give the last value above the last frame", "[Stops]") {
+
+    Stops widths(Stops::Widths(YAML::Load("[ [10, 1], [26, 5] ]"), {}));
+    Stops widthLookup = widths;
+    widthLookup.buildLookup(StyleParamKey::width);
+
+    // The table ends at zoom 24, before the last frame
+    REQUIRE(widthLookup.lookup.size() == 25);
+
+    StyleParam::Value expected, value;
+    for (float zoom : { 24.f, 25.f, 26.f, 27.f }) {
+        Stops::eval(widths, StyleParamKey::width, zoom, expected);
+        Stops::eval(widthLookup, StyleParamKey::width, zoom, value);
+        CHECK(value.get<float>() == expected.get<float>());
+    }
+
+    Stops::eval(widthLookup, StyleParamKey::width, 26, value);
+    REQUIRE(value.get<float>() == widths.frames.back().value.get<float>());
+
+}
+
 TEST_CASE("Stops parses correctly from YAML distance values", "[Stops][YAML]") {
 
     YAML::Node node = YAML::Load("[ [10, 0], [16, .04], [18, .2], [19, .2] ]");
@@ -113,3 +113,33 @@ TEST_CASE("Merging of dirty Regions - Merge three regions, when 3rd region is ad
     }
 
 }
+
+struct TestPixelTexture : public Texture {
+    TestPixelTexture() : Texture(TextureOptions{}) {}
+    const GLubyte* data() { return m_buffer.get(); }
+};
+
+TEST_CASE("Downsampling averages pixel blocks", "[Texture]") {
+    TestPixelTexture texture{};
+
+    // 4x2 RGBA: Left half black, right half white
+    std::vector<GLubyte> pixels(4 * 2 * 4, 0);
+    for (int y = 0; y < 2; y++) {
+        for (int x = 2; x < 4; x++) {
+            for (int c = 0; c < 4; c++) { pixels[(y * 4 + x) * 4 + c] = 255; }
+        }
+    }
+    REQUIRE(texture.setPixelData(4, 2, 4, pixels.data(), pixels.size()));
+
+    // Does not go below the requested size
+    REQUIRE(!texture.downsample(2));
+    REQUIRE(texture.width() == 4);
+
+    REQUIRE(texture.downsample(1));
+    REQUIRE(texture.width() == 2);
+    REQUIRE(texture.height() == 1);
+    REQUIRE(texture.bufferSize() == 2 * 4);
+
+    REQUIRE(texture.data()[0] == 0);
+    REQUIRE(texture.data()[4] == 255);
+}
@@ -0,0 +1,146 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+
+#include <memory>
+
+using namespace Tangram;
+
+#define TAGS "[TileBuilder]"
+
+// Two layers of one source: 'water' is drawn as polygons, 'roads' as lines
+static std::string sceneYaml(const std::string& _waterCollection, const std::string& _roadsCollection) {
+    return R"END(
+sources:
+    src:
+        type: GeoJSON
+        url: https://example.com/tiles/{z}/{x}/{y}.json
+layers:
+    water:
+        data: { source: src, layer: )END" + _waterCollection + R"END( }
+        draw:
+            polygons: { order: 0, color: blue }
+    roads:
+        data: { source: src, layer: )END" + _roadsCollection + R"END( }
+        draw:
+            lines: { order: 1, color: white, width: 2px }
+)END";
+}
+
+static std::unique_ptr<Scene> loadScene(MockPlatform& _platform, const std::string& _yaml) {
+    SceneOptions options{_yaml, Url("/")};
+    options.numTileWorkers = 0;
+    options.prefetchTiles = false;
+
+    auto scene = std::make_unique<Scene>(_platform, std::move(options));
+    REQUIRE(scene->load());
+    return scene;
+}
+
+static const Style& findStyle(const Scene& _scene, const std::string& _name) {
+    for (const auto& style : _scene.styles()) {
+        if (style->getName() == _name) { return *style; }
+    }
+    FAIL("No style " << _name);
+    return *_scene.styles().front();
+}
+
+// TileData with one square polygon in each of @_collections
+static TileData tileData(const std::vector<std::string>& _collections) {
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.polygons = { { {
+                {0.25f, 0.25f},
+                {0.75f, 0.25f},
+                {0.75f, 0.75f},
+                {0.25f, 0.75f},
+                {0.25f, 0.25f}
+            } } };
+
+    TileData data;
+    for (const auto& name : _collections) {
+        data.layers.emplace_back(name);
+        data.layers.back().features.push_back(feature);
+    }
+    return data;
+}
+
+struct BuiltMeshes {
+    bool polygons = false;
+    bool lines = false;
+};
+
+static BuiltMeshes buildTile(TileBuilder& _builder, const Scene& _scene,
+                             const std::vector<std::string>& _collections) {
+    const auto& source = *_scene.tileSources().front();
+    auto tile = _builder.build(TileID(0, 0, 10), tileData(_collections), source);
+
+    BuiltMeshes meshes;
+    meshes.polygons = bool(tile->getMesh(findStyle(_scene, "polygons")));
+    meshes.lines = bool(tile->getMesh(findStyle(_scene, "lines")));
+    return meshes;
+}
+
+TEST_CASE("Tile collections are styled only by the layers that select them", TAGS) {
+    MockPlatform platform;
+    auto scene = loadScene(platform, sceneYaml("water", "roads"));
+
+    TileBuilder builder(*scene);
+    builder.init();
+
+    auto water = buildTile(builder, *scene, { "water" });
+    CHECK(water.polygons);
+    CHECK(!water.lines);
+
+    auto roads = buildTile(builder, *scene, { "roads" });
+    CHECK(!roads.polygons);
+    CHECK(roads.lines);
+
+    auto both = buildTile(builder, *scene, { "water", "roads" });
+    CHECK(both.polygons);
+    CHECK(both.lines);
+
+    // Collections that no layer selects are not styled
+    auto other = buildTile(builder, *scene, { "buildings" });
+    CHECK(!other.polygons);
+    CHECK(!other.lines);
+
+    // Unnamed collections apply to all layers of the source
+    auto unnamed = buildTile(builder, *scene, { "" });
+    CHECK(unnamed.polygons);
+    CHECK(unnamed.lines);
+}
+
+TEST_CASE("Layer collection index follows scene changes", TAGS) {
+    MockPlatform platform;
+    {
+        auto scene = loadScene(platform, sceneYaml("water", "roads"));
+        TileBuilder builder(*scene);
+        builder.init();
+
+        auto water = buildTile(builder, *scene, { "water" });
+        CHECK(water.polygons);
+        CHECK(!water.lines);
+    }
+    {
+        // The new scene swaps the collections of both layers
+        auto scene = loadScene(platform, sceneYaml("roads", "water"));
+        TileBuilder builder(*scene);
+        builder.init();
+
+        auto water = buildTile(builder, *scene, { "water" });
+        CHECK(!water.polygons);
+        CHECK(water.lines);
+
+        auto roads = buildTile(builder, *scene, { "roads" });
+        CHECK(roads.polygons);
+        CHECK(!roads.lines);
+    }
+}
@@ -1,7 +1,9 @@
 #include "catch.hpp"
 
 #include "data/tileSource.h"
+#include "gl/renderState.h"
 #include "mockPlatform.h"
+#include "style/polygonStyle.h"
 #include "tile/tileManager.h"
 #include "tile/tileWorker.h"
 #include "util/mapProjection.h"
@@ -14,10 +16,26 @@ using namespace Tangram;
 
 ViewState viewState { true, glm::vec2(0), 1, 0, 1.f, glm::vec2(0), 256.f };
 
+// Mesh that needs to be uploaded before its tile is drawn
+struct UploadTestMesh : StyledMesh {
+    bool uploaded = false;
+
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) override { return true; }
+    size_t bufferSize() const override { return 1024; }
+    bool isResident() const override { return uploaded; }
+    size_t makeResident(RenderState& rs) override {
+        uploaded = true;
+        return bufferSize();
+    }
+};
+
 struct TestTileWorker : TileTaskQueue {
     int processedCount = 0;
     bool pendingTiles = false;
 
+    // Style for which an UploadTestMesh is added to processed tiles
+    const Style* meshStyle = nullptr;
+
     std::deque<std::shared_ptr<TileTask>> tasks;
 
     void enqueue(std::shared_ptr<TileTask> task) override{
@@ -40,9 +58,7 @@ struct TestTileWorker : TileTaskQueue {
                 continue;
             }
 
-            task->setTile(std::make_unique<Tile>(task->tileId(),
-                                                 task->source()->id(),
-                                                 task->source()->generation()));
+            setTile(*task);
 
             pendingTiles = true;
             processedCount++;
@@ -54,14 +70,22 @@ struct TestTileWorker : TileTaskQueue {
         auto task = tasks[position];
         tasks.erase(tasks.begin() + position);
 
-        task->setTile(std::make_unique<Tile>(task->tileId(),
-                                             task->source()->id(),
-                                             task->source()->generation()));
+        setTile(*task);
 
         pendingTiles = true;
         processedCount++;
     }
 
+    void setTile(TileTask& task) {
+        auto tile = std::make_unique<Tile>(task.tileId(),
+                                           task.source()->id(),
+                                           task.source()->generation());
+        if (meshStyle) {
+            tile->setMesh(*meshStyle, std::make_unique<UploadTestMesh>());
+        }
+        task.setTile(std::move(tile));
+    }
+
     void dropTask() {
         if (!tasks.empty()) {
             auto task = tasks.front();
@@ -309,3 +333,98 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+TEST_CASE( "Tiles are drawn once their meshes are uploaded", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    MockPlatform platform;
+    TestTileManager tileManager(platform, worker);
+    RenderState rs;
+    View view(256, 256);
+
+    PolygonStyle style("polygons");
+    style.setID(0);
+    worker.meshStyle = &style;
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    // Upload one mesh per frame
+    tileManager.setUploadBudget(1024, 1000.f);
+
+    std::set<TileID> visibleTiles_1 = {TileID{0,0,0}};
+    tileManager.updateTiles(viewState, visibleTiles_1);
+    worker.processTask();
+
+    // The tile waits for upload
+    tileManager.updateTiles(viewState, visibleTiles_1);
+    REQUIRE(tileManager.getVisibleTiles().size() == 0);
+    REQUIRE(tileManager.hasLoadingTiles());
+
+    REQUIRE(tileManager.uploadTiles(rs, view));
+    tileManager.updateTiles(viewState, visibleTiles_1);
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE_FALSE(tileManager.hasLoadingTiles());
+    REQUIRE_FALSE(tileManager.uploadTiles(rs, view));
+
+    // Load two child tiles, 0/0/0 is drawn as proxy until they are uploaded
+    std::set<TileID> visibleTiles_2 = {TileID{0,0,1}, TileID{1,0,1}};
+    tileManager.updateTiles(viewState, visibleTiles_2);
+    worker.processTask();
+    worker.processTask();
+
+    tileManager.updateTiles(viewState, visibleTiles_2);
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
+    REQUIRE(tileManager.getVisibleTiles()[0]->isProxy() == true);
+
+    auto numProxies = [&]() {
+        auto& tiles = tileManager.getVisibleTiles();
+        return std::count_if(tiles.begin(), tiles.end(), [](auto& t) { return t->isProxy(); });
+    };
+
+    // One child is uploaded, the proxy still covers the other
+    REQUIRE(tileManager.uploadTiles(rs, view));
+    tileManager.updateTiles(viewState, visibleTiles_2);
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+    REQUIRE(numProxies() == 1);
+
+    REQUIRE(tileManager.uploadTiles(rs, view));
+    tileManager.updateTiles(viewState, visibleTiles_2);
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+    REQUIRE(numProxies() == 0);
+    REQUIRE_FALSE(tileManager.uploadTiles(rs, view));
+}
+
+TEST_CASE( "Tiles are uploaded without upload budget", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    MockPlatform platform;
+    TestTileManager tileManager(platform, worker);
+    RenderState rs;
+    View view(256, 256);
+
+    PolygonStyle style("polygons");
+    style.setID(0);
+    worker.meshStyle = &style;
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    // At least one mesh is uploaded per frame
+    tileManager.setUploadBudget(0, 0.f);
+
+    std::set<TileID> visibleTiles = {TileID{0,0,0}};
+    tileManager.updateTiles(viewState, visibleTiles);
+    worker.processTask();
+    tileManager.updateTiles(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 0);
+
+    REQUIRE(tileManager.uploadTiles(rs, view));
+    tileManager.updateTiles(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->isResident());
+
+    // No more frames are requested for uploads
+    REQUIRE_FALSE(tileManager.uploadTiles(rs, view));
+}
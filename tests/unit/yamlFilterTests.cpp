@@ -238,3 +238,75 @@ TEST_CASE("Sequences in filters implicitly create an 'any' filter", "[filters][c
     REQUIRE(filter.eval(bmw1, ctx));
     REQUIRE(!filter.eval(bike, ctx));
 }
+
+TEST_CASE("Compiled filter programs match filter tree evaluation", "[filters][core][yaml]") {
+    init();
+    civic.geometryType = GeometryType::points;
+    bmw1.geometryType = GeometryType::lines;
+    bike.geometryType = GeometryType::polygons;
+
+    std::vector<std::string> filters = {
+        "filter: { series: !!str 3}",
+        "filter: { name : [civic, bmw320i] }",
+        "filter: {wheel : {min : 2, max : 5}}",
+        "filter: {any : [{name : civic}, {name : bmw320i}]}",
+        "filter: {all : [ {name : civic}, {brand : honda}, {wheel: 4} ] }",
+        "filter: {none : [{name : civic}, {name : bmw320i}]}",
+        "filter: {not : { any: [{name : civic}, {name : bmw320i}]}}",
+        "filter: {$zoom : 10}",
+        "filter: {$zoom : {min : 11}}",
+        "filter: {$geometry : point}",
+        "filter: {$geometry : [line, polygon]}",
+        "filter: { drive : false}",
+        "filter: { serial : [4398046511104] }",
+        "filter: [ { brand: 'bmw' }, { type: 'car' } ]",
+        "filter: {any : [{all: [{brand: honda}, {none: [{type: bike}]}]}, {all: [{wheel: 2}, {$geometry: polygon}]}]}",
+        "filter: {all: []}",
+        "filter: {any: []}",
+    };
+
+    for (const auto& yaml : filters) {
+        Filter filter = load(yaml);
+        FilterProgram program(filter);
+
+        for (auto* feature : { &civic, &bmw1, &bike }) {
+            ctx.setFeature(*feature);
+            INFO(yaml << " - " << feature->props.getString("name"));
+            REQUIRE(program.eval(*feature, ctx) == filter.eval(*feature, ctx));
+        }
+    }
+}
+
+TEST_CASE("Filters specialized to a zoom level match like the original filter", "[filters][core][yaml]") {
+    init();
+
+    std::vector<std::string> filters = {
+        "filter: {$zoom : 10}",
+        "filter: {$zoom : {min : 11}}",
+        "filter: {$zoom : [9, 10]}",
+        "filter: {all : [{$zoom : {min : 8, max : 12}}, {brand : honda}]}",
+        "filter: {any : [{$zoom : {max : 10}}, {name : civic}]}",
+        "filter: {none : [{$zoom : {min : 11}}, {type : bike}]}",
+        "filter: {not : {$zoom : 10}}",
+        "filter: {any : [{all: [{$zoom: {min: 5}}, {brand: honda}]}, {wheel: 2}]}",
+    };
+
+    for (const auto& yaml : filters) {
+        Filter filter = load(yaml);
+
+        for (float zoom : { 5.f, 10.f, 11.f, 14.f }) {
+            Filter specialized = filter.specializeZoom(zoom);
+            ctx.setZoom(zoom);
+
+            for (auto* feature : { &civic, &bmw1, &bike }) {
+                ctx.setFeature(*feature);
+                INFO(yaml << " at " << zoom << " - " << feature->props.getString("name"));
+                REQUIRE(specialized.eval(*feature, ctx) == filter.eval(*feature, ctx));
+            }
+        }
+    }
+
+    CHECK(!load("filter: {$zoom : 10}").specializeZoom(10).isValid());
+    CHECK(load("filter: {$zoom : {min : 11}}").specializeZoom(10).isFalse());
+    CHECK(load("filter: {all : [{$zoom : {min : 8}}, {brand : honda}]}").specializeZoom(10).data.is<Filter::Equality>());
+}